@@ -3,6 +3,7 @@
 
 #include "stdint.h"
 #include "stdbool.h"
+#include "stddef.h"
 
 
 #define NETWORK_RESET_WAIT_TIME		10000	// 10000ms
@@ -10,6 +11,12 @@
 #define CLIENTID_MAX_LEN	64
 #define TOPIC_MAX_LEN       64
 #define PAYLOAD_MAX_LEN     512
+#define MQTT_PUBLISH_INFLIGHT_MAX	4		// Publishes waiting for on_publish, 1 is stop-and-wait
+#define MQTT_PUBLISH_INFLIGHT		2		// Default, see MQTT_set_inflight
+#define MQTT_PUBLISH_ACK_TIMEOUT	10000	// 10s, a publish without on_publish is given up
+#define MQTT_BENCHMARK_MESSAGES		50		// Per in flight setting
+#define MQTT_TX_ARENA_SIZE			2048	// Queued messages, see MQTT_message_begin
+#define MQTT_RX_ARENA_SIZE			1024	// Received messages not handled yet
 
 
 enum {
@@ -17,21 +24,50 @@ enum {
 	SUBTOPIC_COMMAND,
 };
 
+// Acked by the broker, else lost: overwritten, refused by netif or not acknowledged
+typedef void (*MQTT_sent_cb_t)(bool acked);
+
+// Lives in the queue arena, sized to its topic and payload
 typedef struct {
+    MQTT_sent_cb_t on_sent;		// Once per accepted message, NULL for none. Not kept by the outbox
+    char * payload;				// Right after the topic in the same record
+    uint16_t payload_size;		// Room for the payload, terminator included
 	uint8_t topic_id;
-    char topic[TOPIC_MAX_LEN];
-    char payload[PAYLOAD_MAX_LEN];
     uint8_t qos;
     uint8_t retain;
+    uint8_t latest;				// Latest wins: replaces the queued message of the same topic
+    uint8_t persist;			// Event published from the EEPROM outbox, kept there until acked
+    char topic[];
 }MQTT_message_t;
 
+typedef struct {
+	uint32_t published;			// Accepted by netif_mqtt_publish
+	uint32_t acked;				// Completed by on_publish with success
+	uint32_t failed;			// Completed by on_publish with an error
+	uint32_t ack_timeouts;		// Given up after MQTT_PUBLISH_ACK_TIMEOUT
+	uint32_t last_ack_ms;		// Publish to on_publish
+	uint32_t max_ack_ms;
+	uint8_t max_inflight;		// Deepest pipeline seen
+	uint32_t coalesced;			// Latest wins messages overwritten before being sent
+	uint32_t dropped;			// Refused because the queue was full, or the outbox for a persist one
+	uint16_t tx_max_used;		// Queue arena high water mark, bytes
+	uint16_t rx_max_used;
+}MQTT_stats_t;
+
 void MQTT_init();
 void MQTT_run();
 
 
 bool MQTT_is_ready();
+MQTT_message_t * MQTT_message_begin(const char * topic, size_t payload_size);
+MQTT_message_t * MQTT_persist_begin(const char * topic, size_t payload_size);
 bool MQTT_sent_message(MQTT_message_t * message);
-bool MQTT_receive_message(MQTT_message_t * message);
+MQTT_message_t * MQTT_receive_message();
+void MQTT_release_message(MQTT_message_t * message);
+void MQTT_set_inflight(uint8_t inflight);
+MQTT_stats_t * MQTT_get_stats();
+void MQTT_reset_stats();
+void MQTT_benchmark();
 
 
 #endif //MQTT_H
@@ -11,9 +11,19 @@
 #include "stdio.h"
 #include "stdbool.h"
 
+typedef struct {
+	uint32_t full;			// Status with every field
+	uint32_t delta;			// Status with the fields changed since the last acknowledged one
+	uint32_t critical;		// Sent early for a TCD or bill acceptor change
+	uint32_t lost;			// Overwritten, refused or not acknowledged
+}STATUSREPORTER_stats_t;
 
 bool STATUSREPORTER_init();
 bool STATUSREPORTER_run();
 void STATUSREPORTER_report_billaccepted(uint32_t bill_value);
+void STATUSREPORTER_report_ledger(uint32_t from, uint32_t to);
+void STATUSREPORTER_set_binary_payload(bool enable);
+STATUSREPORTER_stats_t * STATUSREPORTER_get_stats();
+void STATUSREPORTER_benchmark();
 
 #endif /* INC_APP_STATUSREPORTER_H_ */
@@ -11,9 +11,24 @@
 #include "stdio.h"
 #include "stdbool.h"
 
+#define EEPROM_SIZE			4096	// 24C32
+#define EEPROM_PAGE_SIZE	32
+#define EEPROM_PAGE_COUNT	(EEPROM_SIZE / EEPROM_PAGE_SIZE)
+#define EEPROM_ENDURANCE	1000000	// Write cycles per page
+
+typedef struct {
+	uint32_t read_count;
+	uint32_t write_count;
+	uint32_t page_write_count;
+	uint32_t busy_us;						// Time blocked in EEPROM_read/EEPROM_write
+	uint16_t page_wear[EEPROM_PAGE_COUNT];	// Page writes since reset of stats
+}EEPROM_stats_t;
+
 bool EEPROM_init();
 bool EEPROM_read(uint16_t address , uint8_t * data, size_t data_len);
 bool EEPROM_write(uint16_t address , uint8_t * data, size_t data_len);
+EEPROM_stats_t * EEPROM_get_stats();
+void EEPROM_reset_stats();
 // For test IO
 bool EEPROM_test();
 
@@ -11,13 +11,72 @@
 #include "stdio.h"
 #include "stdbool.h"
 
+/**
+ * Frame buffers use the ST7920 native layout: 64 rows of 16 bytes,
+ * MSB of each byte is the leftmost pixel.
+ */
+#define LCD_WIDTH			128
+#define LCD_HEIGHT			64
+#define LCD_ROW_BYTES		(LCD_WIDTH / 8)
+#define LCD_FRAME_SIZE		(LCD_ROW_BYTES * LCD_HEIGHT)
+
+/**
+ * Text layer, DDRAM characters from the ST7920 ROM shown over GDRAM.
+ * Half width cells of 8x16 pixels, a text frame is LCD_TEXT_ROWS rows
+ * of LCD_TEXT_COLUMNS characters, ' ' is a blank cell.
+ */
+#define LCD_TEXT_COLUMNS	16
+#define LCD_TEXT_ROWS		4
+#define LCD_TEXT_SIZE		(LCD_TEXT_COLUMNS * LCD_TEXT_ROWS)
+#define LCD_TEXT_CELL_WIDTH		(LCD_WIDTH / LCD_TEXT_COLUMNS)
+#define LCD_TEXT_CELL_HEIGHT	(LCD_HEIGHT / LCD_TEXT_ROWS)
+
+// Rectangles inverted on the way to the glass, e.g. a blinking cursor
+#define LCD_OVERLAY_MAX		2
+
+enum {
+	LCD_TRANSPORT_BITBANG,		// CPU writes every byte and strobe
+	LCD_TRANSPORT_DMA			// TIM1 paced DMA writes GDRAM bytes, CPU only addresses spans
+};
+
+enum {
+	LCD_WAIT_MODE_DELAY,		// Fixed worst case delays
+	LCD_WAIT_MODE_BUSY_FLAG		// Poll BF on D7
+};
+
+typedef struct {
+	uint32_t frame_count;
+	uint32_t total_bytes;			// Bytes and commands sent to GDRAM since reset of stats
+	uint16_t last_frame_bytes;		// Data bytes sent for the last frame
+	uint16_t last_frame_commands;	// Address commands sent for the last frame
+	uint32_t last_frame_us;			// CPU time spent on the bus for the last frame
+	uint32_t superseded_count;		// Frames replaced by a newer one before completion
+	uint32_t text_bytes;			// Bytes and commands sent to DDRAM since reset of stats
+	uint32_t total_us;				// CPU time spent on the GDRAM bus since reset of stats
+}LCD_stats_t;
 
+// Called with every byte put on the bus, rs false for commands
+typedef void (*LCD_trace_t)(bool rs, uint8_t data);
 
 bool LCD_init();
 void LCD_clear_screen();
 void LCD_display_str(char * fmt, ...);
-void LCD_draw_bitmap(uint8_t * bitmap_p);
-void LCD_clear_bitmap();
+void LCD_draw_bitmap(const uint8_t * bitmap_p);
+void LCD_draw_region(const uint8_t * bitmap_p, uint8_t y_start, uint8_t y_end);
+void LCD_draw_text(const char * text_p);
+void LCD_set_overlay(uint8_t id, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+void LCD_show_overlay(uint8_t id, bool on);
+bool LCD_is_frame_complete();
+void LCD_flush();
+void LCD_invalidate();
+LCD_stats_t * LCD_get_stats();
+void LCD_reset_stats();
+void LCD_set_trace(LCD_trace_t trace);
+void LCD_set_wait_mode(uint8_t mode);
+uint8_t LCD_get_wait_mode();
+void LCD_set_transport(uint8_t transport);
+uint8_t LCD_get_transport();
+void LCD_benchmark();
 bool LCD_test();
 
 #endif /* INC_DEVICE_LCD_H_ */
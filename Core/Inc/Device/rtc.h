@@ -8,6 +8,11 @@
 #ifndef INC_HAL_RTC_H_
 #define INC_HAL_RTC_H_
 
+#include "stdio.h"
+#include "stdbool.h"
+
+#define RTC_NVRAM_SIZE	56	// DS1307 battery-backed SRAM, 0x08 - 0x3F
+
 typedef struct {
 	uint8_t second;
 	uint8_t minute;
@@ -20,5 +25,7 @@ typedef struct {
 void RTC_init();
 RTC_t RTC_get_time();
 void RTC_set_time(RTC_t *rtc);
+bool RTC_read_nvram(uint8_t offset, uint8_t *data, size_t data_len);
+bool RTC_write_nvram(uint8_t offset, uint8_t *data, size_t data_len);
 
 #endif /* INC_HAL_RTC_H_ */
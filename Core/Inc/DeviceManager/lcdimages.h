@@ -0,0 +1,27 @@
+/*
+ * lcdimages.h
+ *
+ * Generated by Tools/lcdimage/lcdimage.py, do not edit.
+ */
+
+#ifndef INC_DEVICEMANAGER_LCDIMAGES_H_
+#define INC_DEVICEMANAGER_LCDIMAGES_H_
+
+#include "stdio.h"
+
+typedef struct {
+	uint8_t width;
+	uint8_t height;
+	uint16_t size;			// Compressed bytes
+	const uint8_t *data;	// PackBits of the native layout rows
+}LCDIMG_t;
+
+extern const LCDIMG_t LCDIMG_card_empty;
+extern const LCDIMG_t LCDIMG_card_error;
+extern const LCDIMG_t LCDIMG_card_lower;
+extern const LCDIMG_t LCDIMG_logo;
+extern const LCDIMG_t LCDIMG_processing;
+extern const LCDIMG_t LCDIMG_welcome;
+extern const LCDIMG_t LCDIMG_working;
+
+#endif /* INC_DEVICEMANAGER_LCDIMAGES_H_ */
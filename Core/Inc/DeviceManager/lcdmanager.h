@@ -28,6 +28,61 @@ enum {
 	LCDMNG_SETTING_DATA_CONFIRMED
 };
 
+enum {
+	LCDMNG_STATE_INIT,
+	LCDMNG_STATE_WAIT_FOR_INIT,
+	LCDMNG_STATE_WELCOME,
+	LCDMNG_STATE_WAIT_FOR_WELCOME,
+	LCDMNG_STATE_WORKING,
+	LCDMNG_STATE_PASSWORD,
+	LCDMNG_STATE_SETTING,
+	LCDMNG_STATE_SETTING_DATA,
+	LCDMNG_STATE_CARD_LOWER,
+	LCDMNG_STATE_CARD_EMPTY,
+	LCDMNG_STATE_CARD_ERROR,
+	LCDMNG_STATE_IDLE,
+	LCDMNG_STATE_MAX
+};
+
+// Screens, composed on demand into the shared framebuffer
+enum {
+	LCDMNG_SCREEN_NONE,
+	LCDMNG_SCREEN_LOGO,
+	LCDMNG_SCREEN_WELCOME,
+	LCDMNG_SCREEN_WORKING,
+	LCDMNG_SCREEN_PASSWORD,
+	LCDMNG_SCREEN_SETTING,
+	LCDMNG_SCREEN_SETTING_DATA,
+	LCDMNG_SCREEN_CARD_LOWER,
+	LCDMNG_SCREEN_CARD_EMPTY,
+	LCDMNG_SCREEN_CARD_ERROR,
+	LCDMNG_SCREEN_MAX
+};
+
+typedef struct {
+	uint32_t entries;				// Times the state was entered
+	uint32_t draws;					// Screens shown while in the state
+	uint32_t timeouts_scheduled;
+	uint32_t timeouts_leaked;		// Still pending when the next one was scheduled
+}LCDMNG_state_metrics_t;
+
+typedef struct {
+	uint32_t draws;					// Full compositions
+	uint32_t updates;				// Widgets redrawn in place
+	uint32_t bytes;					// Bytes and commands on the bus while the screen was shown
+	uint32_t bus_us;				// CPU time on the GDRAM bus while the screen was shown
+	uint32_t compose_us;			// CPU time composing the screen
+}LCDMNG_screen_metrics_t;
+
+typedef struct {
+	uint32_t since;					// HAL_GetTick() of the last reset
+	LCDMNG_state_metrics_t states[LCDMNG_STATE_MAX];
+	LCDMNG_screen_metrics_t screens[LCDMNG_SCREEN_MAX];
+}LCDMNG_metrics_t;
+
+// Called by LCDMNG_draw_screens once a frame is on the glass
+typedef void (*LCDMNG_frame_done_t)(const char * name);
+
 void LCDMNG_init();
 void LCDMNG_run();
 void LCDMNG_set_init_screen();
@@ -47,6 +102,10 @@ void LCDMNG_clear_card_empty_screen();
 void LCDMNG_set_idle_screen();
 void LCDMNG_clear_idle_screen();
 void LCDMNG_test();
+void LCDMNG_draw_screens(LCDMNG_frame_done_t frame_done);
+void LCDMNG_get_metrics(LCDMNG_metrics_t *metrics);
+void LCDMNG_reset_metrics();
+void LCDMNG_log_metrics();
 
 
 #endif /* INC_DEVICEMANAGER_LCDMANAGER_H_ */
@@ -12,11 +12,33 @@
 #include "stdbool.h"
 
 #define I2C_TIMEOUT	200 	// 200ms
+#define I2C_REQUEST_QUEUE_SIZE		8
+#define I2C_STANDARD_MODE_SPEED		100000	// DS1307 shares the bus and only supports 100kHz
+
+typedef void (*I2C_callback_t)(bool success, void * arg);
+
+typedef struct {
+	uint8_t address;
+	uint16_t mem_address;
+	uint16_t mem_size;		// 0 for plain master transfer
+	uint8_t * data;
+	size_t data_len;
+	bool is_read;
+	uint32_t timeout;		// ms, 0 for I2C_TIMEOUT
+	I2C_callback_t callback;
+	void * arg;
+}I2C_request_t;
 
 void I2C_init();
+void I2C_run();
+bool I2C_submit(I2C_request_t * request);
+bool I2C_is_idle();
+bool I2C_recover_bus();
+bool I2C_is_device_ready(uint8_t address, uint32_t trials);
 bool I2C_write(uint8_t address, uint8_t * data_w, size_t w_len);
 bool I2C_write_and_read(uint8_t address, uint8_t * data_w, size_t w_len, uint8_t * data_r, size_t r_len);
 bool I2C_read(uint8_t address, uint8_t * data_r, size_t r_len);
 bool I2C_mem_write(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_w, size_t w_len);
+bool I2C_mem_read(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_r, size_t r_len);
 
 #endif /* INC_HAL_I2C_H_ */
@@ -0,0 +1,36 @@
+/*
+ * arena.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+#ifndef INC_ARENA_H_
+#define INC_ARENA_H_
+
+#include "stdio.h"
+#include "stdbool.h"
+
+#define ARENA_ALIGN				4		// Record header and data alignment, buffer must be aligned too
+
+// Ring of variable length records over a caller buffer
+typedef struct {
+	uint8_t *buf;
+	uint16_t size;
+	uint16_t head;				// Oldest record
+	uint16_t tail;				// Next record goes here
+	uint16_t used;				// Bytes from head to tail, wrap padding included
+	uint16_t count;				// Live records
+	uint16_t max_used;			// High water mark
+	uint32_t failed;			// Reservations which did not fit
+}ARENA_t;
+
+void ARENA_init(ARENA_t *arena, uint8_t *buf, size_t size);
+void * ARENA_reserve(ARENA_t *arena, size_t len);
+void ARENA_commit(ARENA_t *arena, void *data, size_t len);
+void ARENA_release(ARENA_t *arena, void *data);
+void * ARENA_first(ARENA_t *arena);
+void * ARENA_next(ARENA_t *arena, void *data);
+bool ARENA_test();
+
+#endif /* INC_ARENA_H_ */
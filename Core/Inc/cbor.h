@@ -0,0 +1,31 @@
+/*
+ * cbor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+#ifndef INC_CBOR_H_
+#define INC_CBOR_H_
+
+#include "stdio.h"
+#include "stdbool.h"
+
+// Streaming CBOR (RFC 8949) writer into a caller buffer, definite lengths only
+typedef struct {
+	uint8_t *buf;
+	size_t size;
+	size_t len;
+	bool overflow;		// Something did not fit, len stops growing
+}CBOR_writer_t;
+
+void CBOR_init(CBOR_writer_t *writer, uint8_t *buf, size_t size);
+void CBOR_put_uint(CBOR_writer_t *writer, uint32_t value);
+void CBOR_put_int(CBOR_writer_t *writer, int32_t value);
+void CBOR_put_bool(CBOR_writer_t *writer, bool value);
+void CBOR_put_text(CBOR_writer_t *writer, const char *text);
+void CBOR_put_bytes(CBOR_writer_t *writer, const uint8_t *data, size_t data_len);
+void CBOR_begin_array(CBOR_writer_t *writer, size_t count);
+void CBOR_begin_map(CBOR_writer_t *writer, size_t count);
+
+#endif /* INC_CBOR_H_ */
@@ -41,7 +41,15 @@ typedef struct {
 bool CONFIG_init();
 CONFIG_t * CONFIG_get();
 void CONFIG_set(CONFIG_t *);
+// Transaction: CONFIG_set calls between begin and commit only update RAM,
+// commit persists everything with a single record write
+CONFIG_t * CONFIG_transaction_begin();
+void CONFIG_transaction_commit();
+void CONFIG_transaction_abort();
+bool CONFIG_is_in_transaction();
+void CONFIG_flush();
 void CONFIG_clear();
+void CONFIG_printf();
 void CONFIG_test();
 
 #endif /* INC_APP_CONFIG_H_ */
@@ -0,0 +1,45 @@
+/*
+ * ledger.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+#ifndef INC_LEDGER_H_
+#define INC_LEDGER_H_
+
+#include "stdio.h"
+#include "stdbool.h"
+#include "Device/rtc.h"
+#include "Device/tcd.h"
+
+#define LEDGER_RECORD_MAX			64		// Must divide 65536 (sequence wrap)
+#define LEDGER_INDEX_DAY_MAX		32
+#define LEDGER_TCD_NONE				0xFF
+
+enum {
+	LEDGER_TYPE_BILL = 1,
+	LEDGER_TYPE_CARD
+};
+
+// Fixed 16 bytes, also the raw export format. Stored with a checksum
+typedef struct {
+	uint16_t sequence;
+	uint8_t type;
+	uint8_t tcd_id;
+	uint32_t timestamp;		// Seconds since 01/01/2000
+	uint32_t value;			// Bill value or card price
+	uint32_t amount;		// Amount after this record
+}LEDGER_record_t;
+
+bool LEDGER_init();
+bool LEDGER_append_bill(uint32_t bill_value, uint32_t amount);
+bool LEDGER_append_card(TCD_id_t id, uint32_t card_price, uint32_t amount);
+uint16_t LEDGER_seek(uint32_t from);
+size_t LEDGER_read(uint16_t *cursor, uint32_t from, uint32_t to, LEDGER_record_t *records, size_t max_records);
+bool LEDGER_is_end(uint16_t cursor);
+size_t LEDGER_get_count();
+uint32_t LEDGER_timestamp(RTC_t *rtc);
+void LEDGER_test();
+
+#endif /* INC_LEDGER_H_ */
@@ -0,0 +1,36 @@
+/*
+ * outbox.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+#ifndef INC_OUTBOX_H_
+#define INC_OUTBOX_H_
+
+#include "stdio.h"
+#include "stdbool.h"
+#include "App/mqtt.h"
+
+#define OUTBOX_RECORD_MAX			16		// Must divide 65536 (sequence wrap), oldest is overwritten when full
+#define OUTBOX_RECORD_SIZE			64		// 2 EEPROM pages
+#define OUTBOX_RECORD_HEADER_LEN	8
+#define OUTBOX_DATA_MAX				(OUTBOX_RECORD_SIZE - OUTBOX_RECORD_HEADER_LEN)	// Topic and payload
+
+typedef struct {
+	uint32_t spilled;			// Messages written to EEPROM
+	uint32_t drained;			// Acknowledged by the broker and released
+	uint32_t overwritten;		// Lost, the outbox was full
+	uint32_t too_long;			// Topic and payload over OUTBOX_DATA_MAX
+	uint32_t corrupted;			// Bad checksum while draining
+}OUTBOX_stats_t;
+
+bool OUTBOX_init();
+bool OUTBOX_push(MQTT_message_t * message);
+MQTT_message_t * OUTBOX_next(uint16_t * sequence);
+void OUTBOX_ack(uint16_t sequence);
+void OUTBOX_rewind();
+size_t OUTBOX_get_count();
+OUTBOX_stats_t * OUTBOX_get_stats();
+
+#endif /* INC_OUTBOX_H_ */
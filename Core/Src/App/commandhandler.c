@@ -9,6 +9,7 @@
 #include "config.h"
 #include "App/commandhandler.h"
 #include "App/mqtt.h"
+#include "App/statusreporter.h"
 #include "Lib/jsmn/jsmn.h"
 #include "Lib/utils/utils_logger.h"
 
@@ -20,16 +21,24 @@ enum {
 enum {
 	COMMAND_RESET,
 	COMMAND_DELETE_TOTAL_CARD,
-	COMMAND_DELETE_TOTAL_AMOUNT
+	COMMAND_DELETE_TOTAL_AMOUNT,
+	COMMAND_EXPORT_LEDGER,
+	COMMAND_SET_BINARY_PAYLOAD
 };
 
+typedef struct {
+	uint8_t command;
+	uint32_t from;
+	uint32_t to;
+	uint32_t value;
+}COMMANDHANDLER_command_t;
+
 static uint8_t state = COMMANDHANDLE_IDLE;
-static MQTT_message_t message;
 
 static void COMMANDHANDLER_handle_config(uint8_t * payload, size_t payload_len);
 static void COMMANDHANDLER_handle_command(uint8_t * payload, size_t payload_len);
 static bool COMMANDHANDLER_parse_config(uint8_t *payload, size_t payload_len, CONFIG_t *config);
-static bool COMMANDHANDLER_parse_command(uint8_t *payload, size_t payload_len, uint8_t *command);
+static bool COMMANDHANDLER_parse_command(uint8_t *payload, size_t payload_len, COMMANDHANDLER_command_t *command);
 
 
 bool COMMANDHANDLER_init(){
@@ -37,17 +46,19 @@ bool COMMANDHANDLER_init(){
 }
 
 bool COMMANDHANDLER_run(){
-	if(MQTT_receive_message(&message)){
-		switch (message.topic_id) {
+	MQTT_message_t * message = MQTT_receive_message();
+	if(message != NULL){
+		switch (message->topic_id) {
 			case SUBTOPIC_CONFIG:
-				COMMANDHANDLER_handle_config(message.payload, strlen(message.payload));
+				COMMANDHANDLER_handle_config(message->payload, strlen(message->payload));
 				break;
 			case SUBTOPIC_COMMAND:
-				COMMANDHANDLER_handle_command(message.payload, strlen(message.payload));
+				COMMANDHANDLER_handle_command(message->payload, strlen(message->payload));
 				break;
 			default:
 				break;
 		}
+		MQTT_release_message(message);
 	}
 }
 
@@ -61,10 +72,15 @@ static void COMMANDHANDLER_handle_config(uint8_t * payload, size_t payload_len){
 static void COMMANDHANDLER_handle_command(uint8_t * payload, size_t payload_len){
 	// Parse command
 	utils_log_info("Payload: %s\r\n", (char*)payload);
-	uint8_t command;
+	COMMANDHANDLER_command_t command = {
+		.command = 0xFF,
+		.from = 0,
+		.to = 0xFFFFFFFF,
+		.value = 0
+	};
 	CONFIG_t *config;
 	if(COMMANDHANDLER_parse_command(payload, payload_len, &command)){
-		switch (command) {
+		switch (command.command) {
 			case COMMAND_RESET:
 				utils_log_info("COMMAND_RESET\r\n");
 				NVIC_SystemReset();
@@ -83,6 +99,14 @@ static void COMMANDHANDLER_handle_command(uint8_t * payload, size_t payload_len)
 				config->total_amount = 0;
 				CONFIG_set(config);
 				break;
+			case COMMAND_EXPORT_LEDGER:
+				utils_log_info("COMMAND_EXPORT_LEDGER: %d - %d\r\n", command.from, command.to);
+				STATUSREPORTER_report_ledger(command.from, command.to);
+				break;
+			case COMMAND_SET_BINARY_PAYLOAD:
+				utils_log_info("COMMAND_SET_BINARY_PAYLOAD: %d\r\n", command.value);
+				STATUSREPORTER_set_binary_payload(command.value != 0);
+				break;
 			default:
 				break;
 		}
@@ -125,7 +149,7 @@ static bool COMMANDHANDLER_parse_config(uint8_t *payload, size_t payload_len, CO
 }
 
 
-static bool COMMANDHANDLER_parse_command(uint8_t *payload, size_t payload_len, uint8_t *command){
+static bool COMMANDHANDLER_parse_command(uint8_t *payload, size_t payload_len, COMMANDHANDLER_command_t *command){
 	jsmn_parser p;
 	jsmntok_t t[PAYLOAD_MAX_LEN]; /* We expect no more than 128 tokens */
 
@@ -146,8 +170,17 @@ static bool COMMANDHANDLER_parse_command(uint8_t *payload, size_t payload_len, u
 	/* Loop over all keys of the root object */
 	for (uint32_t i = 1; i < r; i++) {
 		if (jsmn_streq(payload, &t[i], "cmd") == 0) {
-			* command = (uint8_t)utils_string_to_int(payload + t[i + 1].start, t[i + 1].end - t[i + 1].start);
-			utils_log_debug("- Command: %d\r\n", * command);
+			command->command = (uint8_t)utils_string_to_int(payload + t[i + 1].start, t[i + 1].end - t[i + 1].start);
+			utils_log_debug("- Command: %d\r\n", command->command);
+			i++;
+		} else if (jsmn_streq(payload, &t[i], "from") == 0) {
+			command->from = (uint32_t)utils_string_to_int(payload + t[i + 1].start, t[i + 1].end - t[i + 1].start);
+			i++;
+		} else if (jsmn_streq(payload, &t[i], "to") == 0) {
+			command->to = (uint32_t)utils_string_to_int(payload + t[i + 1].start, t[i + 1].end - t[i + 1].start);
+			i++;
+		} else if (jsmn_streq(payload, &t[i], "value") == 0) {
+			command->value = (uint32_t)utils_string_to_int(payload + t[i + 1].start, t[i + 1].end - t[i + 1].start);
 			i++;
 		}
 	}
@@ -7,8 +7,9 @@
 
 #include <App/mqtt.h>
 #include "config.h"
+#include "outbox.h"
+#include "arena.h"
 #include "Lib/netif/inc/netif.h"
-#include "Lib/utils/utils_buffer.h"
 #include "Lib/utils/utils_logger.h"
 
 
@@ -28,16 +29,55 @@ static void on_disconnect_cb(uint8_t status);
 static void on_message_cb(char * topic, char * payload);
 static void on_publish_cb(uint8_t status);
 static uint8_t mqtt_subtopic_to_id(char * topic);
+static MQTT_message_t * mqtt_message_reserve(ARENA_t * arena, const char * topic, size_t payload_size);
+static size_t mqtt_message_len(MQTT_message_t * message);
+static bool mqtt_tx_pop(MQTT_message_t ** message, int32_t * sequence);
+static void mqtt_tx_coalesce(MQTT_message_t * message);
+static void mqtt_tx_release(MQTT_message_t * message, int32_t sequence);
+static void mqtt_inflight_push(int32_t sequence, MQTT_sent_cb_t on_sent);
+static bool mqtt_inflight_pop(uint32_t * sent, int32_t * sequence, MQTT_sent_cb_t * on_sent);
+static void mqtt_notify_sent(MQTT_sent_cb_t on_sent, bool acked);
+static void mqtt_inflight_expire();
+static bool mqtt_inflight_is_draining();
+static void mqtt_inflight_clear();
+static void mqtt_run_benchmark();
+static void mqtt_benchmark_begin();
+static void mqtt_benchmark_sent(bool acked);
 
 // Internal State
 static uint8_t mqtt_state = MQTT_WAIT_FOR_INTERNET_CONNECTED;
 
-// Flag for limit time between 2 publish message
-static bool timeout_to_publish_flag = false;
+// Publishes waiting for on_publish, send time of the oldest first
+static uint32_t inflight_sent[MQTT_PUBLISH_INFLIGHT_MAX];
+static int32_t inflight_sequence[MQTT_PUBLISH_INFLIGHT_MAX];	// Outbox sequence, -1 from RAM
+static MQTT_sent_cb_t inflight_on_sent[MQTT_PUBLISH_INFLIGHT_MAX];
+static uint8_t inflight_head = 0;
+static uint8_t inflight_count = 0;
+static uint8_t inflight_max = MQTT_PUBLISH_INFLIGHT;
+static bool inflight_draining = false;		// Window given up, late completions are dropped
+static uint32_t inflight_drain_start;
+static MQTT_stats_t stats;
 
-// Tx-Rx Buffer
-static utils_buffer_t mqtt_tx_buffer;
-static utils_buffer_t mqtt_rx_buffer;
+// Benchmark
+static bool benchmark_enable = false;
+static bool benchmark_running = false;
+static uint8_t benchmark_inflight;
+static uint32_t benchmark_queued;
+static uint32_t benchmark_start;
+static uint32_t benchmark_acked;		// Own counters, stats keep counting the real traffic
+static uint32_t benchmark_lost;
+static uint32_t benchmark_max_ack_ms;
+
+// Tx-Rx queues, messages are built and published in place
+static uint32_t mqtt_tx_buf[MQTT_TX_ARENA_SIZE / sizeof(uint32_t)];
+static uint32_t mqtt_rx_buf[MQTT_RX_ARENA_SIZE / sizeof(uint32_t)];
+static ARENA_t mqtt_tx_arena;
+static ARENA_t mqtt_rx_arena;
+static MQTT_message_t * publish_message = NULL;		// Being handed to netif, not popped again
+// Persist message built aside when the queue is full, it only goes to the outbox
+static uint32_t mqtt_spill_buf[(sizeof(MQTT_message_t) + TOPIC_MAX_LEN + OUTBOX_DATA_MAX) / sizeof(uint32_t) + 2];
+static ARENA_t mqtt_spill_arena;
+static MQTT_message_t * spill_message = NULL;
 
 // Callback flag - Unused
 static bool connected = false;
@@ -79,8 +119,9 @@ void MQTT_init(){
 		memcpy(subtopic_entry[var], topic_temp, TOPIC_MAX_LEN);
 	}
     // Init Tx-Rx Buffer;
-    utils_buffer_init(&mqtt_tx_buffer, sizeof(MQTT_message_t));
-    utils_buffer_init(&mqtt_rx_buffer, sizeof(MQTT_message_t));
+    ARENA_init(&mqtt_tx_arena, (uint8_t*)mqtt_tx_buf, sizeof(mqtt_tx_buf));
+    ARENA_init(&mqtt_rx_arena, (uint8_t*)mqtt_rx_buf, sizeof(mqtt_rx_buf));
+    ARENA_init(&mqtt_spill_arena, (uint8_t*)mqtt_spill_buf, sizeof(mqtt_spill_buf));
     // Init netif
     netif_init();
 }
@@ -91,13 +132,14 @@ void MQTT_init(){
  *2. Publish
  */
 void MQTT_run(){
-    static MQTT_message_t publish_message;
+    static int32_t publish_sequence = -1;
 	static uint32_t last_sent = 0;
 	static uint8_t subtopic_idx = 0;
 	static uint8_t subtopic_size = sizeof(subtopic_entry) / sizeof(subtopic_entry[0]);
 	bool internet_connected = false;
 	netif_status_t ret;
 	netif_run();
+	mqtt_run_benchmark();
 	switch (mqtt_state) {
 		case MQTT_WAIT_FOR_INTERNET_CONNECTED:
 			if(NETIF_GET_TIME_MS() - last_sent < NETWORK_RESET_WAIT_TIME){
@@ -155,30 +197,39 @@ void MQTT_run(){
 			}
 			break;
         case MQTT_CLIENT_PUBLISH:
-        	if(NETIF_GET_TIME_MS() - last_sent < COMMAND_INTERVAL){
-				break;
-			}
-			ret = netif_mqtt_publish(&mqtt_client, publish_message.topic,
-													publish_message.payload,
-													publish_message.qos,
-													publish_message.retain);
+			// No fixed gap, the next one goes out as soon as a slot of the pipeline is free
+			ret = netif_mqtt_publish(&mqtt_client, publish_message->topic,
+													publish_message->payload,
+													publish_message->qos,
+													publish_message->retain);
 			if(ret == NETIF_OK){
 				last_sent = NETIF_GET_TIME_MS();
-				utils_log_info("Mqtt Publish OK\r\n");
+				mqtt_inflight_push(publish_sequence, publish_message->on_sent);
+				mqtt_tx_release(publish_message, publish_sequence);
+				publish_message = NULL;
+				utils_log_debug("Mqtt Publish OK\r\n");
                 mqtt_state = MQTT_CLIENT_IDLE;
 			}else if(ret  != NETIF_IN_PROCESS){
 				// Restart when not connect to MQTT
+				mqtt_notify_sent(publish_message->on_sent, false);
+				mqtt_tx_release(publish_message, publish_sequence);
+				publish_message = NULL;
+				mqtt_inflight_clear();
 				mqtt_state = MQTT_RESTART;
 			}
 			break;
 		case MQTT_CLIENT_IDLE:
 			// Check if Mqtt disconnected
             if(!connected){
+            	mqtt_inflight_clear();
                 mqtt_state = MQTT_CLIENT_CONNECT;
+                break;
             }
-            // Check if Mqtt have message to sent
-            else if(utils_buffer_is_available(&mqtt_tx_buffer)){
-                utils_buffer_pop(&mqtt_tx_buffer, &publish_message);
+            mqtt_inflight_expire();
+            // Check if Mqtt have message to sent and room in the pipeline
+            if(inflight_count < inflight_max
+            		&& !mqtt_inflight_is_draining()
+            		&& mqtt_tx_pop(&publish_message, &publish_sequence)){
                 mqtt_state = MQTT_CLIENT_PUBLISH;
             }
 			break;
@@ -205,31 +256,329 @@ bool MQTT_is_ready(){
     return mqtt_state == MQTT_CLIENT_IDLE;
 }
 
+/**
+ * Room in the queue for a message to topic with payload_size bytes of
+ * payload, terminator included. Set the fields, write the payload in
+ * place and hand it to MQTT_sent_message before the next one is begun.
+ * NULL when the queue is full, a message begun but not sent costs nothing.
+ */
+MQTT_message_t * MQTT_message_begin(const char * topic, size_t payload_size){
+	MQTT_message_t * message = mqtt_message_reserve(&mqtt_tx_arena, topic, payload_size);
+	if(message == NULL){
+		utils_log_warn("Mqtt message buffer is full\r\n");
+		stats.dropped++;
+	}
+	return message;
+}
+
+/**
+ * MQTT_message_begin for an event with persist set, MQTT_sent_message
+ * writes it to the EEPROM outbox. When the queue is full it is built
+ * aside. NULL when it fits neither.
+ */
+MQTT_message_t * MQTT_persist_begin(const char * topic, size_t payload_size){
+	MQTT_message_t * message = mqtt_message_reserve(&mqtt_tx_arena, topic, payload_size);
+	if(message == NULL){
+		// Never committed, the next one takes the same room
+		message = mqtt_message_reserve(&mqtt_spill_arena, topic, payload_size);
+		spill_message = message;
+	}
+	if(message == NULL){
+		utils_log_warn("Mqtt message buffer is full\r\n");
+		stats.dropped++;
+		return NULL;
+	}
+	message->persist = 1;
+	return message;
+}
+
+/**
+ * Queue a message from MQTT_message_begin or MQTT_persist_begin. Queued
+ * events keep their order, a message with latest set overwrites the one
+ * of the same topic still queued, so a link down does not fill the queue
+ * with stale status copies. A message with persist set is written to the
+ * EEPROM outbox before it is published and stays there until its own
+ * publish is acked, a failure, a timeout, a link down or a reset sends it
+ * again. Only when the outbox refuses it, it is queued in RAM.
+ */
 bool MQTT_sent_message(MQTT_message_t * message){
-    if(utils_buffer_is_full(&mqtt_tx_buffer)){
-    	utils_log_warn("Mqtt message buffer is full\r\n");
-        return false;
-    }
-    utils_buffer_push(&mqtt_tx_buffer,message);
-    return true;
+	if(message->persist){
+		if(OUTBOX_push(message)){
+			// A reservation in the queue is never committed, the next one takes the same room
+			spill_message = NULL;
+			return true;
+		}
+		if(message == spill_message){
+			spill_message = NULL;
+			stats.dropped++;
+			return false;
+		}
+		utils_log_warn("Mqtt persist message queued in RAM\r\n");
+	}
+	if(message->latest){
+		mqtt_tx_coalesce(message);
+	}
+	ARENA_commit(&mqtt_tx_arena, message, mqtt_message_len(message));
+	stats.tx_max_used = mqtt_tx_arena.max_used;
+	return true;
 }
 
-bool MQTT_receive_message(MQTT_message_t * message){
-    if(!utils_buffer_is_available(&mqtt_rx_buffer)){
-        return false;
-    }
-    utils_buffer_pop(&mqtt_rx_buffer,message);
-    return true;
+// Oldest received message, valid until MQTT_release_message
+MQTT_message_t * MQTT_receive_message(){
+	return ARENA_first(&mqtt_rx_arena);
+}
+
+void MQTT_release_message(MQTT_message_t * message){
+	ARENA_release(&mqtt_rx_arena, message);
+}
+
+/**
+ * Publishes sent before the first on_publish, 1 waits for every
+ * completion like the old fixed interval did without the 2s gap.
+ */
+void MQTT_set_inflight(uint8_t inflight){
+	if(inflight < 1){
+		inflight = 1;
+	}
+	if(inflight > MQTT_PUBLISH_INFLIGHT_MAX){
+		inflight = MQTT_PUBLISH_INFLIGHT_MAX;
+	}
+	inflight_max = inflight;
+}
+
+MQTT_stats_t * MQTT_get_stats(){
+	return &stats;
+}
+
+void MQTT_reset_stats(){
+	memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Publish MQTT_BENCHMARK_MESSAGES QoS1 messages to <id>/rp/bench for
+ * every in flight setting up to MQTT_PUBLISH_INFLIGHT_MAX and log the
+ * messages per second. Runs from MQTT_run once connected, point
+ * mqtt_client.host at a local broker to leave the WAN out of it.
+ * Tools/mqttsim runs it on a model of the AT link.
+ */
+void MQTT_benchmark(){
+	benchmark_inflight = 1;
+	benchmark_running = false;
+	benchmark_enable = true;
+}
+
+static void mqtt_run_benchmark(){
+	char topic[TOPIC_MAX_LEN];
+	MQTT_message_t * message;
+	uint32_t elapsed;
+	uint32_t rate;
+	if(!benchmark_enable || !connected
+			|| (mqtt_state != MQTT_CLIENT_IDLE && mqtt_state != MQTT_CLIENT_PUBLISH)){
+		return;
+	}
+	if(!benchmark_running){
+		mqtt_benchmark_begin();
+	}
+	snprintf(topic, TOPIC_MAX_LEN, "%s/rp/bench", CONFIG_get()->device_id);
+	while(benchmark_queued < MQTT_BENCHMARK_MESSAGES
+			&& (message = mqtt_message_reserve(&mqtt_tx_arena, topic, 16)) != NULL){
+		message->qos = 1;
+		message->on_sent = mqtt_benchmark_sent;
+		snprintf(message->payload, message->payload_size, "{\"seq\":%d}", benchmark_queued);
+		MQTT_sent_message(message);
+		benchmark_queued++;
+	}
+	if(benchmark_acked + benchmark_lost < MQTT_BENCHMARK_MESSAGES){
+		return;
+	}
+	elapsed = NETIF_GET_TIME_MS() - benchmark_start;
+	if(elapsed == 0){
+		elapsed = 1;
+	}
+	rate = MQTT_BENCHMARK_MESSAGES * 100000 / elapsed;
+	utils_log_info("MQTT_benchmark: inflight %d, %d msgs in %d ms, %d.%02d msgs/s, max ack %d ms, %d lost\r\n",
+					benchmark_inflight,
+					MQTT_BENCHMARK_MESSAGES,
+					elapsed,
+					rate / 100,
+					rate % 100,
+					benchmark_max_ack_ms,
+					benchmark_lost);
+	utils_log_info("MQTT_benchmark: tx queue %d of %d B used at most\r\n",
+					mqtt_tx_arena.max_used,
+					MQTT_TX_ARENA_SIZE);
+	benchmark_running = false;
+	benchmark_inflight++;
+	if(benchmark_inflight > MQTT_PUBLISH_INFLIGHT_MAX){
+		benchmark_enable = false;
+		inflight_max = MQTT_PUBLISH_INFLIGHT;
+	}
+}
+
+static void mqtt_benchmark_begin(){
+	inflight_max = benchmark_inflight;
+	benchmark_queued = 0;
+	benchmark_acked = 0;
+	benchmark_lost = 0;
+	benchmark_max_ack_ms = 0;
+	benchmark_start = NETIF_GET_TIME_MS();
+	benchmark_running = true;
+}
+
+// Failed, timed out or flushed benchmark messages are lost, not retried
+static void mqtt_benchmark_sent(bool acked){
+	if(acked){
+		benchmark_acked++;
+	}else{
+		benchmark_lost++;
+	}
+}
+
+// Events first, they must not wait behind status. Persist events are in the outbox, the queue only has those it refused
+static bool mqtt_tx_pop(MQTT_message_t ** message, int32_t * sequence){
+	MQTT_message_t * queued;
+	uint16_t outbox_sequence;
+	*sequence = -1;
+	for (queued = ARENA_first(&mqtt_tx_arena); queued != NULL; queued = ARENA_next(&mqtt_tx_arena, queued)) {
+		if(!queued->latest){
+			*message = queued;
+			return true;
+		}
+	}
+	if(OUTBOX_get_count() > 0){
+		// One at a time: a completion can only be its own, a lost one
+		// never lets the next completion release an outbox record
+		if(inflight_count > 0){
+			return false;
+		}
+		if((*message = OUTBOX_next(&outbox_sequence)) != NULL){
+			*sequence = outbox_sequence;
+			return true;
+		}
+	}
+	for (queued = ARENA_first(&mqtt_tx_arena); queued != NULL; queued = ARENA_next(&mqtt_tx_arena, queued)) {
+		if(queued->latest){
+			*message = queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Drop the queued message of the same topic, the one being published is already gone
+static void mqtt_tx_coalesce(MQTT_message_t * message){
+	MQTT_message_t * queued;
+	for (queued = ARENA_first(&mqtt_tx_arena); queued != NULL; queued = ARENA_next(&mqtt_tx_arena, queued)) {
+		if(queued->latest
+				&& queued != publish_message
+				&& strncmp(queued->topic, message->topic, TOPIC_MAX_LEN) == 0){
+			mqtt_notify_sent(queued->on_sent, false);
+			ARENA_release(&mqtt_tx_arena, queued);
+			stats.coalesced++;
+			return;
+		}
+	}
+}
+
+// Handed to netif, the queue space is free again. Outbox messages stay in EEPROM until acked
+static void mqtt_tx_release(MQTT_message_t * message, int32_t sequence){
+	if(sequence < 0){
+		ARENA_release(&mqtt_tx_arena, message);
+	}
+}
+
+/**
+ * Header, topic and room for the payload in one record. The payload
+ * follows the topic terminator, MQTT_sent_message shrinks the record
+ * to what was written.
+ */
+static MQTT_message_t * mqtt_message_reserve(ARENA_t * arena, const char * topic, size_t payload_size){
+	size_t topic_len = strnlen(topic, TOPIC_MAX_LEN - 1);
+	MQTT_message_t * message = ARENA_reserve(arena, sizeof(MQTT_message_t) + topic_len + 1 + payload_size);
+	if(message == NULL){
+		return NULL;
+	}
+	memset(message, 0, sizeof(MQTT_message_t));
+	memcpy(message->topic, topic, topic_len);
+	message->topic[topic_len] = 0;
+	message->payload = &message->topic[topic_len + 1];
+	message->payload[0] = 0;
+	message->payload_size = payload_size;
+	return message;
+}
+
+static size_t mqtt_message_len(MQTT_message_t * message){
+	return (message->payload - (char*)message) + strnlen(message->payload, message->payload_size - 1) + 1;
+}
+
+static void mqtt_inflight_push(int32_t sequence, MQTT_sent_cb_t on_sent){
+	uint8_t tail = (inflight_head + inflight_count) % MQTT_PUBLISH_INFLIGHT_MAX;
+	inflight_sent[tail] = NETIF_GET_TIME_MS();
+	inflight_sequence[tail] = sequence;
+	inflight_on_sent[tail] = on_sent;
+	inflight_count++;
+	stats.published++;
+	if(inflight_count > stats.max_inflight){
+		stats.max_inflight = inflight_count;
+	}
 }
 
-bool mqtt_receive_message_drop_all(){
-	utils_buffer_drop_all(&mqtt_rx_buffer);
+// Completions come back in publish order on the one connection
+static bool mqtt_inflight_pop(uint32_t * sent, int32_t * sequence, MQTT_sent_cb_t * on_sent){
+	if(inflight_count == 0){
+		return false;
+	}
+	*sent = inflight_sent[inflight_head];
+	*sequence = inflight_sequence[inflight_head];
+	*on_sent = inflight_on_sent[inflight_head];
+	inflight_head = (inflight_head + 1) % MQTT_PUBLISH_INFLIGHT_MAX;
+	inflight_count--;
+	return true;
+}
+
+/**
+ * A publish whose on_publish never came. Completions carry no id and
+ * are matched by position, so a late one would release the wrong entry:
+ * the whole window is given up and nothing is published for another
+ * MQTT_PUBLISH_ACK_TIMEOUT, late completions then find it empty and are
+ * dropped. Outbox messages are sent again.
+ */
+static void mqtt_inflight_expire(){
+	if(inflight_count == 0
+			|| NETIF_GET_TIME_MS() - inflight_sent[inflight_head] < MQTT_PUBLISH_ACK_TIMEOUT){
+		return;
+	}
+	stats.ack_timeouts += inflight_count;
+	utils_log_warn("Mqtt publish not acknowledged, %d in flight given up\r\n", inflight_count);
+	mqtt_inflight_clear();
+	inflight_draining = true;
+	inflight_drain_start = NETIF_GET_TIME_MS();
 }
 
+static bool mqtt_inflight_is_draining(){
+	if(inflight_draining
+			&& NETIF_GET_TIME_MS() - inflight_drain_start >= MQTT_PUBLISH_ACK_TIMEOUT){
+		inflight_draining = false;
+	}
+	return inflight_draining;
+}
 
+// Outbox messages not acknowledged yet are sent again once connected
+static void mqtt_inflight_clear(){
+	uint32_t sent;
+	int32_t sequence;
+	MQTT_sent_cb_t on_sent;
+	while(mqtt_inflight_pop(&sent, &sequence, &on_sent)){
+		mqtt_notify_sent(on_sent, false);
+	}
+	inflight_head = 0;
+	OUTBOX_rewind();
+}
 
-static void timeout_to_publish(){
-	timeout_to_publish_flag = true;
+static void mqtt_notify_sent(MQTT_sent_cb_t on_sent, bool acked){
+	if(on_sent != NULL){
+		on_sent(acked);
+	}
 }
 
 
@@ -245,14 +594,52 @@ static void on_disconnect_cb(uint8_t status){
 
 static void on_message_cb(char * topic, char * payload){
 	utils_log_debug("On message callback: topic %s, payload %s\r\n", topic,payload);
-    MQTT_message_t message;
-    message.topic_id = mqtt_subtopic_to_id(topic);
-    memcpy(message.payload, payload , strlen(payload));
-	utils_buffer_push(&mqtt_rx_buffer, &message);
+	size_t payload_len = strlen(payload);
+    MQTT_message_t * message = mqtt_message_reserve(&mqtt_rx_arena, topic, payload_len + 1);
+    if(message == NULL){
+    	utils_log_warn("Mqtt receive buffer is full\r\n");
+    	return;
+    }
+    message->topic_id = mqtt_subtopic_to_id(topic);
+    memcpy(message->payload, payload, payload_len + 1);
+    ARENA_commit(&mqtt_rx_arena, message, mqtt_message_len(message));
+    stats.rx_max_used = mqtt_rx_arena.max_used;
 }
 
+// Ack times only cover successful completions, outbox records are only released by those
 static void on_publish_cb(uint8_t status){
+	uint32_t sent;
+	int32_t sequence;
+	MQTT_sent_cb_t on_sent;
+	uint32_t ack_ms;
 	utils_log_debug("On publish callback\r\n");
+	if(!mqtt_inflight_pop(&sent, &sequence, &on_sent)){
+		utils_log_debug("Late publish completion dropped\r\n");
+		return;
+	}
+	if(status != NETIF_OK){
+		stats.failed++;
+		utils_log_warn("Mqtt publish failed\r\n");
+		mqtt_notify_sent(on_sent, false);
+		if(sequence >= 0){
+			// Still pending in the outbox, sent again
+			OUTBOX_rewind();
+		}
+		return;
+	}
+	if(sequence >= 0){
+		OUTBOX_ack(sequence);
+	}
+	mqtt_notify_sent(on_sent, true);
+	ack_ms = NETIF_GET_TIME_MS() - sent;
+	stats.acked++;
+	stats.last_ack_ms = ack_ms;
+	if(ack_ms > stats.max_ack_ms){
+		stats.max_ack_ms = ack_ms;
+	}
+	if(on_sent == mqtt_benchmark_sent && ack_ms > benchmark_max_ack_ms){
+		benchmark_max_ack_ms = ack_ms;
+	}
 }
 
 static uint8_t mqtt_subtopic_to_id(char * topic){
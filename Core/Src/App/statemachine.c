@@ -7,6 +7,7 @@
 
 
 #include "config.h"
+#include "ledger.h"
 #include "App/mqtt.h"
 #include "App/statemachine.h"
 #include "App/statusreporter.h"
@@ -15,6 +16,7 @@
 #include "DeviceManager/keypadmanager.h"
 #include "DeviceManager/tcdmanager.h"
 #include "DeviceManager/lcdmanager.h"
+#include "Hal/i2c.h"
 #include "Lib/scheduler/scheduler.h"
 #include "Lib/utils/utils_logger.h"
 
@@ -73,6 +75,7 @@ bool STATEMACHINE_init(){
 }
 
 bool STATEMACHINE_run(){
+	I2C_run();
 	MQTT_run();
 	STATUSREPORTER_run();
 	COMMANDHANDLER_run();
@@ -311,16 +314,20 @@ static void SM_printf(){
 static void SM_take_card_cb(TCD_id_t id){
 	utils_log_info("TCD_%d: Card is taken\r\n", id);
 	// Get config & time
-	CONFIG_t *config = CONFIG_get();
 	RTC_t rtc = RTC_get_time();
 	uint32_t amount = BILLACCEPTORMNG_get_amount();
+	CONFIG_t *config = CONFIG_get();
 	// Update amount
 	amount -= config->card_price;
+	// Ledger first, LEDGER_init applies it when the config write is cut
+	LEDGER_append_card(id, config->card_price, amount);
+	// Amount and counters are persisted together in one write
+	config = CONFIG_transaction_begin();
 	config->total_card++;
 	config->total_card_by_day++;
 	config->total_card_by_month++;
-	CONFIG_set(config);
 	BILLACCEPTORMNG_set_amount(amount);
+	CONFIG_transaction_commit();
 	LCDMNG_set_working_screen(&rtc, config->amount);
 }
 
@@ -5,130 +5,758 @@
  *      Author: xuanthodo
  */
 
+#include "stddef.h"
+#include "main.h"
 #include "config.h"
+#include "ledger.h"
+#include "outbox.h"
+#include "cbor.h"
 #include <App/mqtt.h>
 #include "App/statusreporter.h"
 #include "DeviceManager/billacceptormanager.h"
 #include "DeviceManager/tcdmanager.h"
+#include "DeviceManager/lcdmanager.h"
 #include "Lib/scheduler/scheduler.h"
+#include "Lib/utils/utils_logger.h"
 
 #define STATUSREPORT_INTERVAL		30 * 1000 	// 5 minutes
+#define STATUSREPORTER_FULL_CYCLES	10			// Every 10th report sends every field, for resync
+#define STATUSREPORTER_CRITICAL_INTERVAL	2000	// Min ms between reports of TCD / bill acceptor changes
+#define LEDGER_EXPORT_HEADER_LEN	4
+// Records per message so that header + records still fit in payload as base64
+#define LEDGER_EXPORT_RECORD_MAX	((((PAYLOAD_MAX_LEN - 1) / 4 * 3) - LEDGER_EXPORT_HEADER_LEN) / sizeof(LEDGER_record_t))
+// Binary payloads are CBOR sent as base64, netif publishes C strings
+#define STATUSREPORTER_BINARY_PAYLOAD	false	// Default, COMMAND_SET_BINARY_PAYLOAD switches it
+#define STATUSREPORTER_BINARY_SUFFIX	"/cbor"
+#define STATUSREPORTER_CBOR_MAX			((PAYLOAD_MAX_LEN - 1) / 4 * 3)
+#define STATUSREPORTER_BILL_PAYLOAD_MAX	32		// {"value":4294967295} or its CBOR as base64
+#define STATUSREPORTER_BENCHMARK_ROUNDS	100
+
+// Integer keys of the CBOR maps, Tools/cbordecode names them back
+enum {
+	STATUSREPORTER_KEY_VERSION,
+	STATUSREPORTER_KEY_PASSWORD,
+	STATUSREPORTER_KEY_CARD_PRICE,
+	STATUSREPORTER_KEY_AMOUNT,
+	STATUSREPORTER_KEY_TOTAL_AMOUNT,
+	STATUSREPORTER_KEY_TOTAL_CARD,
+	STATUSREPORTER_KEY_TOTAL_CARD_BY_DAY,
+	STATUSREPORTER_KEY_TOTAL_CARD_BY_MONTH,
+	STATUSREPORTER_KEY_TCD_1,
+	STATUSREPORTER_KEY_TCD_2,
+	STATUSREPORTER_KEY_BILL,
+	STATUSREPORTER_KEY_LCD,
+	STATUSREPORTER_KEY_LCD_DRAWS,
+	STATUSREPORTER_KEY_MQTT,
+	STATUSREPORTER_KEY_MAX
+};
+
+#define STATUSREPORTER_FIELDS_ALL	((1UL << STATUSREPORTER_KEY_MAX) - 1)
+// Counters which only grow, a change of them alone is not worth a report. Sent in full ones
+#define STATUSREPORTER_FIELDS_TELEMETRY	((1UL << STATUSREPORTER_KEY_LCD) | (1UL << STATUSREPORTER_KEY_LCD_DRAWS) | (1UL << STATUSREPORTER_KEY_MQTT))
+
+enum {
+	STATUSREPORTER_BILL_KEY_VALUE
+};
+
+enum {
+	STATUSREPORTER_LEDGER_KEY_FIRST_SEQUENCE,
+	STATUSREPORTER_LEDGER_KEY_MORE,
+	STATUSREPORTER_LEDGER_KEY_RECORDS		// [sequence, type, tcd_id, timestamp delta, value, amount]
+};
+
+enum {
+	STATUSREPORTER_LCD_DRAWS,
+	STATUSREPORTER_LCD_UPDATES,
+	STATUSREPORTER_LCD_BYTES,
+	STATUSREPORTER_LCD_LEAKED,
+	STATUSREPORTER_LCD_MAX
+};
+
+// What the status carries, numbers as uint32_t so that fields compare and print alike
+typedef struct {
+	char version[VERSION_MAX_LEN];
+	char password[SETTING_MODE_PASSWORD_MAX_LEN];
+	uint32_t card_price;
+	uint32_t amount;
+	uint32_t total_amount;
+	uint32_t total_card;
+	uint32_t total_card_by_day;
+	uint32_t total_card_by_month;
+	uint32_t tcd_1[3];
+	uint32_t tcd_2[3];
+	uint32_t bill;
+	uint32_t lcd[STATUSREPORTER_LCD_MAX];
+	uint32_t lcd_draws[4];
+	uint32_t mqtt[3];
+}STATUSREPORTER_snapshot_t;
+
+typedef struct {
+	uint8_t offset;
+	uint8_t size;
+	uint8_t count;		// Numbers, 0 for a string
+}STATUSREPORTER_field_t;
+
+#define STATUSREPORTER_FIELD_SIZE(member)	sizeof(((STATUSREPORTER_snapshot_t*)0)->member)
+#define STATUSREPORTER_TEXT(member)		{offsetof(STATUSREPORTER_snapshot_t, member), STATUSREPORTER_FIELD_SIZE(member), 0}
+#define STATUSREPORTER_NUMBER(member)	{offsetof(STATUSREPORTER_snapshot_t, member), STATUSREPORTER_FIELD_SIZE(member), STATUSREPORTER_FIELD_SIZE(member) / sizeof(uint32_t)}
+
+static const STATUSREPORTER_field_t status_fields[STATUSREPORTER_KEY_MAX] = {
+	[STATUSREPORTER_KEY_VERSION] = STATUSREPORTER_TEXT(version),
+	[STATUSREPORTER_KEY_PASSWORD] = STATUSREPORTER_TEXT(password),
+	[STATUSREPORTER_KEY_CARD_PRICE] = STATUSREPORTER_NUMBER(card_price),
+	[STATUSREPORTER_KEY_AMOUNT] = STATUSREPORTER_NUMBER(amount),
+	[STATUSREPORTER_KEY_TOTAL_AMOUNT] = STATUSREPORTER_NUMBER(total_amount),
+	[STATUSREPORTER_KEY_TOTAL_CARD] = STATUSREPORTER_NUMBER(total_card),
+	[STATUSREPORTER_KEY_TOTAL_CARD_BY_DAY] = STATUSREPORTER_NUMBER(total_card_by_day),
+	[STATUSREPORTER_KEY_TOTAL_CARD_BY_MONTH] = STATUSREPORTER_NUMBER(total_card_by_month),
+	[STATUSREPORTER_KEY_TCD_1] = STATUSREPORTER_NUMBER(tcd_1),
+	[STATUSREPORTER_KEY_TCD_2] = STATUSREPORTER_NUMBER(tcd_2),
+	[STATUSREPORTER_KEY_BILL] = STATUSREPORTER_NUMBER(bill),
+	[STATUSREPORTER_KEY_LCD] = STATUSREPORTER_NUMBER(lcd),
+	[STATUSREPORTER_KEY_LCD_DRAWS] = STATUSREPORTER_NUMBER(lcd_draws),
+	[STATUSREPORTER_KEY_MQTT] = STATUSREPORTER_NUMBER(mqtt),
+};
+
+// JSON names of the STATUSREPORTER_KEY_*
+static const char * const status_keys[STATUSREPORTER_KEY_MAX] = {
+	[STATUSREPORTER_KEY_VERSION] = "v",
+	[STATUSREPORTER_KEY_PASSWORD] = "pwd",
+	[STATUSREPORTER_KEY_CARD_PRICE] = "cp",
+	[STATUSREPORTER_KEY_AMOUNT] = "amt",
+	[STATUSREPORTER_KEY_TOTAL_AMOUNT] = "to_amt",
+	[STATUSREPORTER_KEY_TOTAL_CARD] = "to_ca",
+	[STATUSREPORTER_KEY_TOTAL_CARD_BY_DAY] = "to_ca_d",
+	[STATUSREPORTER_KEY_TOTAL_CARD_BY_MONTH] = "to_ca_m",
+	[STATUSREPORTER_KEY_TCD_1] = "tcd_1",
+	[STATUSREPORTER_KEY_TCD_2] = "tcd_2",
+	[STATUSREPORTER_KEY_BILL] = "bill",
+	[STATUSREPORTER_KEY_LCD] = "lcd",
+	[STATUSREPORTER_KEY_LCD_DRAWS] = "lcd_d",
+	[STATUSREPORTER_KEY_MQTT] = "mq",
+};
 
 static bool timeout_flag = true;
+static uint8_t status_cycles = 0;
+static uint32_t status_critical_tick = 0;
+static bool status_full_pending = true;
+static bool status_full_queued = false;		// A full status is queued or in flight, not called back yet
+// Last snapshot acknowledged by the broker, the last queued one, the one being built
+static STATUSREPORTER_snapshot_t status_reported;
+static STATUSREPORTER_snapshot_t status_pending;
+static STATUSREPORTER_snapshot_t status_snapshot;
+static bool status_reported_valid = false;
+static uint8_t status_outstanding = 0;		// Queued or in flight, not called back yet
+static STATUSREPORTER_stats_t status_stats;
+static bool binary_payload = STATUSREPORTER_BINARY_PAYLOAD;
+static LCDMNG_metrics_t lcd_metrics;
+static uint8_t cbor_buf[STATUSREPORTER_CBOR_MAX];
+static size_t cbor_len;			// Last CBOR message, before base64
+
+// Ledger export
+static bool ledger_export_enable = false;
+static uint16_t ledger_export_cursor;
+static uint32_t ledger_export_from;
+static uint32_t ledger_export_to;
+static __ALIGNED(4) uint8_t ledger_batch[LEDGER_EXPORT_HEADER_LEN + LEDGER_EXPORT_RECORD_MAX * sizeof(LEDGER_record_t)];
+static const char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
 // Private function
-static void STATUSREPORTER_report_status();
+static bool STATUSREPORTER_report_status(bool full);
+static bool STATUSREPORTER_is_critical_change();
+static void STATUSREPORTER_status_sent(bool acked);
+static void STATUSREPORTER_take_snapshot(STATUSREPORTER_snapshot_t *snapshot);
+static void STATUSREPORTER_tcd_fields(uint32_t * fields, TCD_status_t * status);
+static uint32_t STATUSREPORTER_diff(STATUSREPORTER_snapshot_t *from, STATUSREPORTER_snapshot_t *to);
 static void STATUSREPORTER_build_status_topic(char * buf, char * device_id);
 static void STATUSREPORTER_build_status_payload(char * buf,
-													CONFIG_t* config,
-													TCDMNG_Status_t tcd_status,
-													uint8_t billacepptor_status);
+													STATUSREPORTER_snapshot_t * snapshot,
+													uint32_t fields);
+static void STATUSREPORTER_build_status_cbor(char * buf,
+													STATUSREPORTER_snapshot_t * snapshot,
+													uint32_t fields);
+static void STATUSREPORTER_lcd_totals(uint32_t * totals);
 static void STATUSREPORTER_build_bill_accepted_topic(char * buf, char * device_id);
 static void STATUSREPORTER_build_bill_accepted_payload(char * buf, uint32_t bill_value);
+static void STATUSREPORTER_build_bill_accepted_cbor(char * buf, uint32_t bill_value);
+static void STATUSREPORTER_build_ledger_topic(char * buf, char * device_id);
+static void STATUSREPORTER_build_ledger_payload(char * buf);
+static void STATUSREPORTER_build_ledger_cbor(char * buf);
+static void STATUSREPORTER_put_ledger_records(CBOR_writer_t * writer,
+													uint16_t first_sequence,
+													bool more,
+													LEDGER_record_t * records,
+													size_t count);
+static size_t STATUSREPORTER_fit_ledger_records(uint16_t first_sequence,
+													LEDGER_record_t * records,
+													size_t count);
+static void STATUSREPORTER_finish_cbor(char * buf, CBOR_writer_t * writer);
+static void STATUSREPORTER_run_ledger_export();
+static size_t STATUSREPORTER_base64_encode(char * buf, uint8_t * data, size_t data_len);
 static void STATUSREPORTER_timeout();
 
 bool STATUSREPORTER_init(){
 
 }
 
+/**
+ * Status goes out every STATUSREPORT_INTERVAL with the fields changed
+ * since the last acknowledged one, nothing when none did. All of them,
+ * telemetry counters included, every STATUSREPORTER_FULL_CYCLES.
+ * A TCD or bill acceptor change goes out at once, at most every
+ * STATUSREPORTER_CRITICAL_INTERVAL.
+ */
 bool STATUSREPORTER_run(){
 	if(timeout_flag){
 		timeout_flag = false;
+		if(++status_cycles >= STATUSREPORTER_FULL_CYCLES){
+			status_cycles = 0;
+			status_full_pending = true;
+		}
 		// Publish status
-		STATUSREPORTER_report_status();
+		if(STATUSREPORTER_report_status(status_full_pending)){
+			status_full_pending = false;
+		}
 		SCH_Add_Task(STATUSREPORTER_timeout, STATUSREPORT_INTERVAL, 0);
+	}else if(HAL_GetTick() - status_critical_tick >= STATUSREPORTER_CRITICAL_INTERVAL
+			&& STATUSREPORTER_is_critical_change()){
+		status_critical_tick = HAL_GetTick();
+		status_stats.critical++;
+		if(STATUSREPORTER_report_status(status_full_pending)){
+			status_full_pending = false;
+		}
+	}
+	STATUSREPORTER_run_ledger_export();
+}
+
+/**
+ * Publish status, bill_accepted and ledger as base64 CBOR on the topics
+ * suffixed with /cbor instead of JSON. Not persisted, back to JSON on reset.
+ */
+void STATUSREPORTER_set_binary_payload(bool enable){
+	binary_payload = enable;
+	// Other topic, its first status has every field
+	status_full_pending = true;
+	utils_log_info("STATUSREPORTER binary payload: %d\r\n", enable);
+}
+
+STATUSREPORTER_stats_t * STATUSREPORTER_get_stats(){
+	return &status_stats;
+}
+
+/**
+ * Bytes on the wire and encode time of the JSON and CBOR payloads, on
+ * the current status and on a synthetic ledger batch. Clobbers the ledger
+ * batch, run it before the superloop.
+ */
+void STATUSREPORTER_benchmark(){
+	static char payload[PAYLOAD_MAX_LEN];
+	LEDGER_record_t *records = (LEDGER_record_t*)ledger_batch;
+	CBOR_writer_t writer;
+	uint32_t json_cycles = 0;
+	uint32_t cbor_cycles = 0;
+	uint32_t start;
+	size_t json_len;
+	size_t raw_len;
+	size_t fit;
+
+	STATUSREPORTER_take_snapshot(&status_snapshot);
+	for (uint32_t round = 0; round < STATUSREPORTER_BENCHMARK_ROUNDS; ++round) {
+		start = DWT->CYCCNT;
+		STATUSREPORTER_build_status_payload(payload, &status_snapshot, STATUSREPORTER_FIELDS_ALL);
+		json_cycles += DWT->CYCCNT - start;
+		start = DWT->CYCCNT;
+		STATUSREPORTER_build_status_cbor(payload, &status_snapshot, STATUSREPORTER_FIELDS_ALL);
+		cbor_cycles += DWT->CYCCNT - start;
+	}
+	STATUSREPORTER_build_status_payload(payload, &status_snapshot, STATUSREPORTER_FIELDS_ALL);
+	json_len = strlen(payload);
+	STATUSREPORTER_build_status_cbor(payload, &status_snapshot, STATUSREPORTER_FIELDS_ALL);
+	utils_log_info("STATUSREPORTER_benchmark: status json %d B %d cycles, cbor %d B (base64 %d B) %d cycles\r\n",
+					json_len,
+					json_cycles / STATUSREPORTER_BENCHMARK_ROUNDS,
+					cbor_len,
+					strlen(payload),
+					cbor_cycles / STATUSREPORTER_BENCHMARK_ROUNDS);
+
+	json_cycles = 0;
+	cbor_cycles = 0;
+	for (uint32_t round = 0; round < STATUSREPORTER_BENCHMARK_ROUNDS; ++round) {
+		start = DWT->CYCCNT;
+		STATUSREPORTER_build_bill_accepted_payload(payload, 200000);
+		json_cycles += DWT->CYCCNT - start;
+		start = DWT->CYCCNT;
+		STATUSREPORTER_build_bill_accepted_cbor(payload, 200000);
+		cbor_cycles += DWT->CYCCNT - start;
+	}
+	STATUSREPORTER_build_bill_accepted_payload(payload, 200000);
+	json_len = strlen(payload);
+	STATUSREPORTER_build_bill_accepted_cbor(payload, 200000);
+	utils_log_info("STATUSREPORTER_benchmark: bill_accepted json %d B %d cycles, cbor %d B (base64 %d B) %d cycles\r\n",
+					json_len,
+					json_cycles / STATUSREPORTER_BENCHMARK_ROUNDS,
+					cbor_len,
+					strlen(payload),
+					cbor_cycles / STATUSREPORTER_BENCHMARK_ROUNDS);
+
+	// A day of sales a few minutes apart, bill then card
+	for (size_t i = 0; i < LEDGER_EXPORT_RECORD_MAX; ++i) {
+		records[i].sequence = 1000 + i;
+		records[i].type = (i % 2) ? LEDGER_TYPE_CARD : LEDGER_TYPE_BILL;
+		records[i].tcd_id = (i % 2) ? TCD_1 : LEDGER_TCD_NONE;
+		records[i].timestamp = 845000000 + i * 180;
+		records[i].value = (i % 2) ? 10000 : 20000;
+		records[i].amount = (i % 2) ? 10000 : 20000;
 	}
+	raw_len = LEDGER_EXPORT_HEADER_LEN + LEDGER_EXPORT_RECORD_MAX * sizeof(LEDGER_record_t);
+	start = DWT->CYCCNT;
+	fit = STATUSREPORTER_fit_ledger_records(1000, records, LEDGER_EXPORT_RECORD_MAX);
+	CBOR_init(&writer, cbor_buf, sizeof(cbor_buf));
+	STATUSREPORTER_put_ledger_records(&writer, 1000, false, records, fit);
+	cbor_cycles = DWT->CYCCNT - start;
+	cbor_len = writer.len;
+	utils_log_info("STATUSREPORTER_benchmark: ledger raw %d records %d B (base64 %d B), cbor %d records %d B (base64 %d B) %d cycles\r\n",
+					LEDGER_EXPORT_RECORD_MAX,
+					raw_len,
+					(raw_len + 2) / 3 * 4,
+					fit,
+					cbor_len,
+					(cbor_len + 2) / 3 * 4,
+					cbor_cycles);
 }
 
 void STATUSREPORTER_report_billaccepted(uint32_t bill_value){
 	CONFIG_t *config = CONFIG_get();
-	MQTT_message_t message = {
-		.qos = 1,
-		.retain = 0
-	};
+	char topic[TOPIC_MAX_LEN];
+	MQTT_message_t *message;
 	// Build Topic
-	STATUSREPORTER_build_bill_accepted_topic(message.topic, config->device_id);
-	STATUSREPORTER_build_bill_accepted_payload(message.payload, bill_value);
+	STATUSREPORTER_build_bill_accepted_topic(topic, config->device_id);
+	// Must survive an outage or a reset, published from the outbox
+	message = MQTT_persist_begin(topic, STATUSREPORTER_BILL_PAYLOAD_MAX);
+	if(message == NULL){
+		return;
+	}
+	message->qos = 1;
+	message->retain = 0;
+	if(binary_payload){
+		STATUSREPORTER_build_bill_accepted_cbor(message->payload, bill_value);
+	}else{
+		STATUSREPORTER_build_bill_accepted_payload(message->payload, bill_value);
+	}
 	// Send message
-	MQTT_sent_message(&message);
+	MQTT_sent_message(message);
 }
 
-static void STATUSREPORTER_report_status(){
+/**
+ * Export ledger records with from <= timestamp <= to to <id>/rp/ledger.
+ * Records are batched as many as fit in one message, payload is base64 of
+ * [first_sequence:2][count:1][more:1] followed by count raw LEDGER_record_t,
+ * or the CBOR map of STATUSREPORTER_build_ledger_cbor to <id>/rp/ledger/cbor.
+ */
+void STATUSREPORTER_report_ledger(uint32_t from, uint32_t to){
+	ledger_export_from = from;
+	ledger_export_to = to;
+	ledger_export_cursor = LEDGER_seek(from);
+	ledger_export_enable = true;
+}
+
+static void STATUSREPORTER_run_ledger_export(){
+	CONFIG_t *config;
+	char topic[TOPIC_MAX_LEN];
+	MQTT_message_t *message;
+	if(!ledger_export_enable){
+		return;
+	}
+	config = CONFIG_get();
+	STATUSREPORTER_build_ledger_topic(topic, config->device_id);
+	// Retry on next run when Mqtt buffer is full, records are read once there is room
+	message = MQTT_message_begin(topic, PAYLOAD_MAX_LEN);
+	if(message == NULL){
+		return;
+	}
+	message->qos = 1;
+	message->retain = 0;
+	if(binary_payload){
+		STATUSREPORTER_build_ledger_cbor(message->payload);
+	}else{
+		STATUSREPORTER_build_ledger_payload(message->payload);
+	}
+	ledger_export_enable = !LEDGER_is_end(ledger_export_cursor);
+	MQTT_sent_message(message);
+}
+
+/**
+ * Publish what changed since the snapshot the broker last acknowledged,
+ * or every field when full is set. Deltas are not retained and a newer
+ * one overwrites the queued one, it still holds every field changed
+ * since that acknowledged snapshot. While a full one is queued the next
+ * is full as well, it would overwrite the full one otherwise.
+ * Returns false when nothing was queued.
+ */
+static bool STATUSREPORTER_report_status(bool full){
 	CONFIG_t *config = CONFIG_get();
-	MQTT_message_t message = {
-		.qos = 1,
-		.retain = 1
-	};
+	char topic[TOPIC_MAX_LEN];
+	MQTT_message_t *message;
+	uint32_t fields = STATUSREPORTER_FIELDS_ALL;
 
+	full = full || status_full_queued;
+	STATUSREPORTER_take_snapshot(&status_snapshot);
+	if(!full){
+		fields = STATUSREPORTER_diff(&status_reported, &status_snapshot);
+		if(fields == 0){
+			// Back to what the broker has, e.g. after a lost report: no critical
+			// change against it anymore. One still in flight keeps its snapshot,
+			// once it is acked the difference is reported.
+			if(status_outstanding == 0){
+				memcpy(&status_pending, &status_snapshot, sizeof(STATUSREPORTER_snapshot_t));
+			}
+			return true;
+		}
+	}
 	// Build Topic
-	STATUSREPORTER_build_status_topic(message.topic, config->device_id);
+	STATUSREPORTER_build_status_topic(topic, config->device_id);
+	message = MQTT_message_begin(topic, PAYLOAD_MAX_LEN);
+	if(message == NULL){
+		return false;
+	}
+	message->qos = 1;
+	message->retain = full;
+	message->latest = 1;		// Only the newest snapshot matters
+	message->on_sent = STATUSREPORTER_status_sent;
 	// Build Payload
+	if(binary_payload){
+		STATUSREPORTER_build_status_cbor(message->payload, &status_snapshot, fields);
+	}else{
+		STATUSREPORTER_build_status_payload(message->payload, &status_snapshot, fields);
+	}
+	// Send message
+	if(!MQTT_sent_message(message)){
+		return false;
+	}
+	memcpy(&status_pending, &status_snapshot, sizeof(STATUSREPORTER_snapshot_t));
+	status_outstanding++;
+	if(full){
+		status_full_queued = true;
+		status_stats.full++;
+	}else{
+		status_stats.delta++;
+	}
+	return true;
+}
+
+// A TCD or the bill acceptor changed state since the last queued status
+static bool STATUSREPORTER_is_critical_change(){
+	uint32_t tcd_1[3];
+	uint32_t tcd_2[3];
 	TCDMNG_Status_t tcd_status = TCDMNG_get_status();
-	uint8_t billacceptor_status = BILLACCEPTORMNG_get_status();
+	STATUSREPORTER_tcd_fields(tcd_1, &tcd_status.TCD_1);
+	STATUSREPORTER_tcd_fields(tcd_2, &tcd_status.TCD_2);
+	return memcmp(tcd_1, status_pending.tcd_1, sizeof(tcd_1)) != 0
+			|| memcmp(tcd_2, status_pending.tcd_2, sizeof(tcd_2)) != 0
+			|| BILLACCEPTORMNG_get_status() != status_pending.bill;
+}
 
-	STATUSREPORTER_build_status_payload(message.payload, config, tcd_status, billacceptor_status);
-	// Send message
-	MQTT_sent_message(&message);
+/**
+ * Only the newest status in the pipeline can move the acknowledged
+ * snapshot, an older one acked after it was queued misses its changes.
+ * The newest is full while a full one was queued, when it is lost the
+ * next report is full again.
+ */
+static void STATUSREPORTER_status_sent(bool acked){
+	if(status_outstanding > 0){
+		status_outstanding--;
+	}
+	if(status_outstanding == 0 && status_full_queued){
+		status_full_queued = false;
+		status_full_pending = status_full_pending || !acked;
+	}
+	if(!acked){
+		status_stats.lost++;
+		return;
+	}
+	if(status_outstanding == 0){
+		memcpy(&status_reported, &status_pending, sizeof(STATUSREPORTER_snapshot_t));
+		status_reported_valid = true;
+	}
 }
+
+static void STATUSREPORTER_take_snapshot(STATUSREPORTER_snapshot_t *snapshot){
+	CONFIG_t *config = CONFIG_get();
+	TCDMNG_Status_t tcd_status = TCDMNG_get_status();
+	MQTT_stats_t *mqtt_stats = MQTT_get_stats();
+	memset(snapshot, 0, sizeof(STATUSREPORTER_snapshot_t));
+	strncpy(snapshot->version, config->version, sizeof(snapshot->version) - 1);
+	strncpy(snapshot->password, config->password, sizeof(snapshot->password) - 1);
+	snapshot->card_price = config->card_price;
+	snapshot->amount = config->amount;
+	snapshot->total_amount = config->total_amount;
+	snapshot->total_card = config->total_card;
+	snapshot->total_card_by_day = config->total_card_by_day;
+	snapshot->total_card_by_month = config->total_card_by_month;
+	STATUSREPORTER_tcd_fields(snapshot->tcd_1, &tcd_status.TCD_1);
+	STATUSREPORTER_tcd_fields(snapshot->tcd_2, &tcd_status.TCD_2);
+	snapshot->bill = BILLACCEPTORMNG_get_status();
+	STATUSREPORTER_lcd_totals(snapshot->lcd);
+	snapshot->lcd_draws[0] = lcd_metrics.screens[LCDMNG_SCREEN_WORKING].draws;
+	snapshot->lcd_draws[1] = lcd_metrics.screens[LCDMNG_SCREEN_CARD_LOWER].draws;
+	snapshot->lcd_draws[2] = lcd_metrics.screens[LCDMNG_SCREEN_CARD_EMPTY].draws;
+	snapshot->lcd_draws[3] = lcd_metrics.screens[LCDMNG_SCREEN_CARD_ERROR].draws;
+	snapshot->mqtt[0] = mqtt_stats->coalesced;
+	snapshot->mqtt[1] = mqtt_stats->dropped;
+	snapshot->mqtt[2] = OUTBOX_get_count();
+}
+
+// Empty, error, lower like the JSON always had them
+static void STATUSREPORTER_tcd_fields(uint32_t * fields, TCD_status_t * status){
+	fields[0] = status->is_empty;
+	fields[1] = status->is_error;
+	fields[2] = status->is_lower;
+}
+
+// One bit per STATUSREPORTER_KEY_*, telemetry counters left out
+static uint32_t STATUSREPORTER_diff(STATUSREPORTER_snapshot_t *from, STATUSREPORTER_snapshot_t *to){
+	uint32_t fields = 0;
+	if(!status_reported_valid){
+		return STATUSREPORTER_FIELDS_ALL;
+	}
+	for (uint8_t key = 0; key < STATUSREPORTER_KEY_MAX; ++key) {
+		if(STATUSREPORTER_FIELDS_TELEMETRY & (1UL << key)){
+			continue;
+		}
+		if(memcmp((uint8_t*)from + status_fields[key].offset,
+					(uint8_t*)to + status_fields[key].offset,
+					status_fields[key].size) != 0){
+			fields |= 1UL << key;
+		}
+	}
+	return fields;
+}
+
 static void STATUSREPORTER_build_status_topic(char * buf, char * device_id){
 	snprintf(buf,
 			TOPIC_MAX_LEN,
-			"%s/rp/status",
-			device_id);
+			"%s/rp/status%s",
+			device_id,
+			binary_payload ? STATUSREPORTER_BINARY_SUFFIX : "");
 }
 
+// JSON object of the fields set, a full one stays well under PAYLOAD_MAX_LEN
 static void STATUSREPORTER_build_status_payload(char * buf,
-													CONFIG_t* config,
-													TCDMNG_Status_t tcd_status,
-													uint8_t billacepptor_status){
-	snprintf(buf,
-				PAYLOAD_MAX_LEN,
-				"{"
-					"\"v\":\"%s\","
-					"\"pwd\":\"%s\","
-					"\"cp\":%d,"
-					"\"amt\":%d,"
-					"\"to_amt\":%d,"
-					"\"to_ca\":%d,"
-					"\"to_ca_d\":%d,"
-					"\"to_ca_m\":%d,"
-					"\"tcd_1\":[%d,%d,%d],"
-					"\"tcd_2\":[%d,%d,%d],"
-					"\"bill\": %d"
-				"}",
-					config->version,
-					config->password,
-					config->card_price,
-					config->amount,
-					config->total_amount,
-					config->total_card,
-					config->total_card_by_day,
-					config->total_card_by_month,
-					tcd_status.TCD_1.is_empty,
-					tcd_status.TCD_1.is_error,
-					tcd_status.TCD_1.is_lower,
-					tcd_status.TCD_2.is_empty,
-					tcd_status.TCD_2.is_error,
-					tcd_status.TCD_2.is_lower,
-					billacepptor_status);
+													STATUSREPORTER_snapshot_t * snapshot,
+													uint32_t fields){
+	size_t len = 0;
+	len += snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "{");
+	for (uint8_t key = 0; key < STATUSREPORTER_KEY_MAX; ++key) {
+		if(!(fields & (1UL << key))){
+			continue;
+		}
+		uint8_t *value = (uint8_t*)snapshot + status_fields[key].offset;
+		uint8_t count = status_fields[key].count;
+		len += snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "%s\"%s\":", len > 1 ? "," : "", status_keys[key]);
+		if(count == 0){
+			len += snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "\"%s\"", (char*)value);
+			continue;
+		}
+		if(count > 1){
+			len += snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "[");
+		}
+		for (uint8_t i = 0; i < count; ++i) {
+			len += snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "%s%d", i > 0 ? "," : "", ((uint32_t*)value)[i]);
+		}
+		if(count > 1){
+			len += snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "]");
+		}
+	}
+	snprintf(&buf[len], PAYLOAD_MAX_LEN - len, "}");
+}
+
+/**
+ * Same content as the JSON status as a CBOR map with integer keys
+ * (STATUSREPORTER_KEY_*), flags and counters as small unsigned ints.
+ */
+static void STATUSREPORTER_build_status_cbor(char * buf,
+													STATUSREPORTER_snapshot_t * snapshot,
+													uint32_t fields){
+	CBOR_writer_t writer;
+	CBOR_init(&writer, cbor_buf, sizeof(cbor_buf));
+	CBOR_begin_map(&writer, __builtin_popcount(fields));
+	for (uint8_t key = 0; key < STATUSREPORTER_KEY_MAX; ++key) {
+		if(!(fields & (1UL << key))){
+			continue;
+		}
+		uint8_t *value = (uint8_t*)snapshot + status_fields[key].offset;
+		uint8_t count = status_fields[key].count;
+		CBOR_put_uint(&writer, key);
+		if(count == 0){
+			CBOR_put_text(&writer, (char*)value);
+			continue;
+		}
+		if(count > 1){
+			CBOR_begin_array(&writer, count);
+		}
+		for (uint8_t i = 0; i < count; ++i) {
+			CBOR_put_uint(&writer, ((uint32_t*)value)[i]);
+		}
+	}
+	STATUSREPORTER_finish_cbor(buf, &writer);
+}
+
+// LCD redraws since boot, a flapping TCD lower/empty input shows as a jump
+static void STATUSREPORTER_lcd_totals(uint32_t * totals){
+	memset(totals, 0, STATUSREPORTER_LCD_MAX * sizeof(uint32_t));
+	LCDMNG_get_metrics(&lcd_metrics);
+	for (uint8_t i = 0; i < LCDMNG_SCREEN_MAX; ++i) {
+		totals[STATUSREPORTER_LCD_DRAWS] += lcd_metrics.screens[i].draws;
+		totals[STATUSREPORTER_LCD_UPDATES] += lcd_metrics.screens[i].updates;
+		totals[STATUSREPORTER_LCD_BYTES] += lcd_metrics.screens[i].bytes;
+	}
+	for (uint8_t i = 0; i < LCDMNG_STATE_MAX; ++i) {
+		totals[STATUSREPORTER_LCD_LEAKED] += lcd_metrics.states[i].timeouts_leaked;
+	}
 }
 
 static void STATUSREPORTER_build_bill_accepted_topic(char * buf, char * device_id){
 	snprintf(buf,
 			TOPIC_MAX_LEN,
-			"%s/rp/bill_accepted",
-			device_id);
+			"%s/rp/bill_accepted%s",
+			device_id,
+			binary_payload ? STATUSREPORTER_BINARY_SUFFIX : "");
 }
 
 static void STATUSREPORTER_build_bill_accepted_payload(char * buf, uint32_t bill_value){
 	snprintf(buf,
-				PAYLOAD_MAX_LEN,
+				STATUSREPORTER_BILL_PAYLOAD_MAX,
 				"{"
 					"\"value\":%d"
 				"}",
 				bill_value);
 }
 
+static void STATUSREPORTER_build_bill_accepted_cbor(char * buf, uint32_t bill_value){
+	CBOR_writer_t writer;
+	CBOR_init(&writer, cbor_buf, sizeof(cbor_buf));
+	CBOR_begin_map(&writer, 1);
+	CBOR_put_uint(&writer, STATUSREPORTER_BILL_KEY_VALUE);
+	CBOR_put_uint(&writer, bill_value);
+	STATUSREPORTER_finish_cbor(buf, &writer);
+}
+
+static void STATUSREPORTER_build_ledger_topic(char * buf, char * device_id){
+	snprintf(buf,
+			TOPIC_MAX_LEN,
+			"%s/rp/ledger%s",
+			device_id,
+			binary_payload ? STATUSREPORTER_BINARY_SUFFIX : "");
+}
+
+static void STATUSREPORTER_build_ledger_payload(char * buf){
+	uint8_t *batch = ledger_batch;
+	uint16_t first_sequence = ledger_export_cursor;
+	size_t count = LEDGER_read(&ledger_export_cursor,
+								ledger_export_from,
+								ledger_export_to,
+								(LEDGER_record_t*)&batch[LEDGER_EXPORT_HEADER_LEN],
+								LEDGER_EXPORT_RECORD_MAX);
+	batch[0] = first_sequence & 0xFF;
+	batch[1] = first_sequence >> 8;
+	batch[2] = count;
+	batch[3] = !LEDGER_is_end(ledger_export_cursor);
+	STATUSREPORTER_base64_encode(buf, batch, LEDGER_EXPORT_HEADER_LEN + count * sizeof(LEDGER_record_t));
+}
+
+/**
+ * CBOR map {first sequence, more, records}, a record is an array of
+ * sequence, type, tcd_id, timestamp as delta to the previous record
+ * (the first one absolute), value and amount.
+ */
+static void STATUSREPORTER_build_ledger_cbor(char * buf){
+	LEDGER_record_t *records = (LEDGER_record_t*)ledger_batch;
+	uint16_t first_sequence = ledger_export_cursor;
+	CBOR_writer_t writer;
+	size_t count = LEDGER_read(&ledger_export_cursor,
+								ledger_export_from,
+								ledger_export_to,
+								records,
+								LEDGER_EXPORT_RECORD_MAX);
+	size_t fit = STATUSREPORTER_fit_ledger_records(first_sequence, records, count);
+	// Records which did not fit go in the next message
+	if(fit < count){
+		ledger_export_cursor = records[fit].sequence;
+	}
+	count = fit;
+	CBOR_init(&writer, cbor_buf, sizeof(cbor_buf));
+	STATUSREPORTER_put_ledger_records(&writer,
+										first_sequence,
+										!LEDGER_is_end(ledger_export_cursor),
+										records,
+										count);
+	STATUSREPORTER_finish_cbor(buf, &writer);
+}
+
+static void STATUSREPORTER_put_ledger_records(CBOR_writer_t * writer,
+													uint16_t first_sequence,
+													bool more,
+													LEDGER_record_t * records,
+													size_t count){
+	uint32_t timestamp = 0;
+	CBOR_begin_map(writer, 3);
+	CBOR_put_uint(writer, STATUSREPORTER_LEDGER_KEY_FIRST_SEQUENCE);
+	CBOR_put_uint(writer, first_sequence);
+	CBOR_put_uint(writer, STATUSREPORTER_LEDGER_KEY_MORE);
+	CBOR_put_bool(writer, more);
+	CBOR_put_uint(writer, STATUSREPORTER_LEDGER_KEY_RECORDS);
+	CBOR_begin_array(writer, count);
+	for (size_t i = 0; i < count; ++i) {
+		CBOR_begin_array(writer, 6);
+		CBOR_put_uint(writer, records[i].sequence);
+		CBOR_put_uint(writer, records[i].type);
+		CBOR_put_uint(writer, records[i].tcd_id);
+		CBOR_put_int(writer, (int32_t)(records[i].timestamp - timestamp));
+		CBOR_put_uint(writer, records[i].value);
+		CBOR_put_uint(writer, records[i].amount);
+		timestamp = records[i].timestamp;
+	}
+}
+
+/**
+ * How many of the records fit in one message, a record takes 13 to 22
+ * bytes depending on its values so it is measured rather than assumed.
+ */
+static size_t STATUSREPORTER_fit_ledger_records(uint16_t first_sequence,
+													LEDGER_record_t * records,
+													size_t count){
+	CBOR_writer_t writer;
+	do{
+		CBOR_init(&writer, NULL, sizeof(cbor_buf));
+		STATUSREPORTER_put_ledger_records(&writer, first_sequence, true, records, count);
+	}while(writer.overflow && --count > 0);
+	return count;
+}
+
+// Base64 into the payload, the encoder stops at cbor_buf which fits it
+static void STATUSREPORTER_finish_cbor(char * buf, CBOR_writer_t * writer){
+	if(writer->overflow){
+		utils_log_error("STATUSREPORTER cbor overflow\r\n");
+	}
+	cbor_len = writer->len;
+	STATUSREPORTER_base64_encode(buf, cbor_buf, writer->len);
+}
+
+static size_t STATUSREPORTER_base64_encode(char * buf, uint8_t * data, size_t data_len){
+	size_t len = 0;
+	for (size_t var = 0; var < data_len; var += 3) {
+		uint32_t triple = data[var] << 16;
+		if(var + 1 < data_len) triple |= data[var + 1] << 8;
+		if(var + 2 < data_len) triple |= data[var + 2];
+		buf[len++] = base64_table[(triple >> 18) & 0x3F];
+		buf[len++] = base64_table[(triple >> 12) & 0x3F];
+		buf[len++] = (var + 1 < data_len) ? base64_table[(triple >> 6) & 0x3F] : '=';
+		buf[len++] = (var + 2 < data_len) ? base64_table[triple & 0x3F] : '=';
+	}
+	buf[len] = 0;
+	return len;
+}
+
 static void STATUSREPORTER_timeout(){
 	timeout_flag = true;
 }
@@ -10,10 +10,12 @@
 #include "string.h"
 #include "Device/eeprom.h"
 #include "Hal/i2c.h"
+#include "Hal/timer.h"
 
 #define EEPROM_ADDRESS	0xA0
 #define EEPROM_ADDRESS_SIZE	4
-#define PAGE_SIZE	32	// 32 bytes
+#define PAGE_SIZE	EEPROM_PAGE_SIZE	// 32 bytes
+#define EEPROM_ACK_POLL_TRIALS	100	// ~10ms at 100kHz, write cycle is 5ms max
 
 enum {
 	EEPROM_READ_OP,
@@ -23,6 +25,7 @@ enum {
 
 static uint8_t i2c_buffer_wr[PAGE_SIZE];
 static uint8_t i2c_buffer_rd[PAGE_SIZE];
+static EEPROM_stats_t stats;
 
 
 bool EEPROM_init(){
@@ -30,27 +33,47 @@ bool EEPROM_init(){
 }
 
 bool EEPROM_read(uint16_t _address , uint8_t * data, size_t data_len){
-	I2C_mem_read(EEPROM_ADDRESS, _address, EEPROM_ADDRESS_SIZE, data, data_len);
-	return true;
+	uint32_t start = TIMER_get_tick_us();
+	bool success = I2C_mem_read(EEPROM_ADDRESS, _address, EEPROM_ADDRESS_SIZE, data, data_len);
+	stats.read_count++;
+	stats.busy_us += TIMER_get_tick_us() - start;
+	return success;
 }
 
 bool EEPROM_write(uint16_t _address, uint8_t * data, size_t data_len){
 	uint16_t address;
 	size_t remain_size = data_len;
 	size_t write_size;
+	bool success = true;
+	uint32_t start = TIMER_get_tick_us();
+	stats.write_count++;
 	for(;remain_size > 0;){
-		if(remain_size > PAGE_SIZE){
-			write_size = PAGE_SIZE;
-		}else{
+		address = _address + data_len - remain_size;
+		// Never cross a page boundary, the device would wrap to page start
+		write_size = PAGE_SIZE - (address % PAGE_SIZE);
+		if(remain_size < write_size){
 			write_size = remain_size;
 		}
-		address = _address + data_len - remain_size;
 		memcpy(i2c_buffer_wr , &data[data_len - remain_size], write_size);
-		I2C_mem_write(EEPROM_ADDRESS, address, EEPROM_ADDRESS_SIZE,  i2c_buffer_wr, write_size);
-		HAL_Delay(5);
+		success = I2C_mem_write(EEPROM_ADDRESS, address, EEPROM_ADDRESS_SIZE,  i2c_buffer_wr, write_size) && success;
+		// Ack polling: device NACKs until its internal write cycle is done
+		success = I2C_is_device_ready(EEPROM_ADDRESS, EEPROM_ACK_POLL_TRIALS) && success;
+		stats.page_write_count++;
+		if(stats.page_wear[(address % EEPROM_SIZE) / PAGE_SIZE] < 0xFFFF){
+			stats.page_wear[(address % EEPROM_SIZE) / PAGE_SIZE]++;
+		}
 		remain_size -= write_size;
 	}
-	return true;
+	stats.busy_us += TIMER_get_tick_us() - start;
+	return success;
+}
+
+EEPROM_stats_t * EEPROM_get_stats(){
+	return &stats;
+}
+
+void EEPROM_reset_stats(){
+	memset(&stats, 0, sizeof(stats));
 }
 
 bool EEPROM_test(){
@@ -8,10 +8,49 @@
 //
 #include "main.h"
 #include "stdarg.h"
+#include "string.h"
 #include "Device/lcd.h"
 #include "Hal/gpio.h"
+#include "Lib/scheduler/scheduler.h"
+#include "Lib/utils/utils_logger.h"
 
 #define LCD_BUFFER_SIZE			256
+#define LCD_GDRAM_ROWS			32
+#define LCD_ROW_WORDS			(LCD_ROW_BYTES / 2)
+#define LCD_GDRAM_MERGE_GAP		1		// Unchanged words cheaper to resend than to re-address
+#define LCD_RENDER_INTERVAL		1		// ms
+#define LCD_RENDER_ROWS_PER_SLICE	4	// Screen rows pushed per LCD_RENDER_INTERVAL
+
+// Bus, D0..D7 are PD8..PD15 so a byte is a single BSRR store
+#define LCD_DATA_PORT			GPIOD
+#define LCD_DATA_SHIFT			8
+#define LCD_CONTROL_PORT		GPIOB
+#define LCD_RS_PIN				GPIO_PIN_13
+#define LCD_RW_PIN				GPIO_PIN_14
+#define LCD_ENABLE_PIN			GPIO_PIN_15
+#define LCD_D7_PIN				GPIO_PIN_15
+#define LCD_DATA_CRH_INPUT		0x44444444	// PD8..PD15 floating input
+#define LCD_SETUP_NS			100		// tAS, tDSW
+#define LCD_ENABLE_PULSE_NS		300		// tPW >= 140ns
+#define LCD_ENABLE_CYCLE_NS		1200	// tC, rising edge to rising edge
+#define LCD_READ_DELAY_NS		200		// tDDR >= 160ns
+#define LCD_BUSY_TIMEOUT_US		2000	// Longer than any instruction but clear
+#define LCD_POWER_ON_MS			40		// Vdd rising to the first instruction
+#define LCD_CLEAR_US			1600	// Display clear, other instructions take 72us
+#define LCD_BENCHMARK_BYTES		256
+
+// DMA transport: every TIM1 period the CH1 compare requests DMA1 channel 2,
+// which stores the next byte to GPIOD->BSRR, and TIM1_CH3N on PB15 pulses E
+// at the end of the period. One pulse mode with the repetition counter stops
+// the timer after the last byte of the span.
+#define LCD_DMA_TIMER			TIM1
+#define LCD_DMA_CHANNEL			DMA1_Channel2
+#define LCD_DMA_FLAGS			DMA_IFCR_CGIF2
+#define LCD_DMA_BYTE_US			80		// Write RAM takes 72us, the busy flag can not be polled
+#define LCD_DMA_DATA_DELAY_NS	1000	// Data changes this long after E falls
+#define LCD_ENABLE_CRH_SHIFT	28		// PB15 in GPIOB->CRH
+#define LCD_ENABLE_CRH_MASK		((uint32_t)0xF << LCD_ENABLE_CRH_SHIFT)
+#define LCD_ENABLE_CRH_AF		((uint32_t)0xB << LCD_ENABLE_CRH_SHIFT)	// Alternate function push pull, 50MHz
 
 //basic commands
 #define LCD_FUNCTIONSET 		0x30u
@@ -47,6 +86,14 @@
 #define LCD_DISPLAY_SHIFT	  0x01u
 #define LCD_DISPLAY_NO_SHIFT  0x00u
 
+typedef struct {
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;
+	uint8_t height;
+	bool on;
+}LCD_overlay_t;
+
 enum {
 	LCD_RS,
 	LCD_RW,
@@ -79,7 +126,30 @@ static const uint8_t offset_line[] = { 0x80u, 0x90u, 0x88u, 0x98u };
 static uint8_t display_control;
 static uint8_t display_function;
 static uint8_t lcd_str_buf[LCD_BUFFER_SIZE];
-static uint8_t lcd_bitmap_buf[32][32];
+static uint32_t lcd_cycles_per_us;
+static uint32_t lcd_setup_cycles;
+static uint32_t lcd_enable_pulse_cycles;
+static uint32_t lcd_enable_cycle_cycles;
+static uint32_t lcd_read_delay_cycles;
+static uint32_t lcd_last_enable;
+static uint32_t lcd_data_crh_output;
+static uint8_t wait_mode = LCD_WAIT_MODE_BUSY_FLAG;
+static uint8_t transport = LCD_TRANSPORT_BITBANG;
+static uint32_t lcd_dma_buf[LCD_ROW_BYTES];		// BSRR words of the span in flight
+static bool lcd_dma_active = false;
+static uint32_t lcd_enable_crh_output;
+static const uint8_t *lcd_bitmap_buf;
+static uint8_t lcd_glass_buf[LCD_FRAME_SIZE];	// What is on the glass, same layout as lcd_bitmap_buf
+static bool lcd_glass_valid = false;
+static int8_t lcd_render_row = -1;		// Next screen row to render, -1 when the frame is complete
+static uint8_t lcd_render_word = 0;		// Where lcd_render_row resumes, DMA transport only
+static uint8_t lcd_render_start;		// Rows [lcd_render_start, lcd_render_end) of the queued frame
+static uint8_t lcd_render_end;
+static char lcd_text_glass[LCD_TEXT_SIZE];	// DDRAM content, same layout as the text frame
+static bool lcd_text_valid = false;
+static LCD_stats_t stats;
+static LCD_trace_t lcd_trace = NULL;
+static LCD_overlay_t lcd_overlays[LCD_OVERLAY_MAX];
 
 /**
  * Section: Private Functions
@@ -92,18 +162,32 @@ static void LCD_home();
 static void LCD_clear();
 static void LCD_no_display();
 static void LCD_display();
-static void LCD_draw_pixel(int8_t x, int8_t y);
-static void LCD_render_bitmap();
+static void LCD_render_task();
+static void LCD_render_rows(uint8_t max_rows);
+static bool LCD_render_row(uint8_t y);
+static bool LCD_is_word_dirty(uint8_t y, uint8_t word);
+static uint8_t LCD_frame_byte(uint8_t y, uint8_t column);
+static uint8_t LCD_overlay_mask(uint8_t y, uint8_t column);
+static void LCD_render_span(uint8_t y, uint8_t first_word, uint8_t last_word);
+static void LCD_text_span(const char * text_p, uint8_t row, uint8_t first_pair, uint8_t last_pair);
 static void LCD_no_blink();
 static void LCD_blink();
 static void LCD_no_cursor();
 static void LCD_cursor();
 static void LCD_set_cursor( uint8_t col, uint8_t row );
 static void LCD_output_pins( uint8_t rs, uint8_t rw, uint8_t data );
+static void LCD_output_pins_gpio( uint8_t rs, uint8_t rw, uint8_t data );
 static void LCD_strobe();
+static void LCD_wait_ready(size_t us);
+static bool LCD_wait_busy_flag();
+static void LCD_dma_init();
+static void LCD_dma_start(uint8_t count);
+static bool LCD_dma_busy();
 static void  LCD_send_command( uint8_t cmd );
 static void LCD_send_data( char d );
 static bool LCD_delay_microseconds(size_t us);
+static void LCD_delay_cycles(uint32_t cycles);
+static uint32_t LCD_ns_to_cycles(uint32_t ns);
 static bool LCD_delay(size_t ms);
 
 
@@ -113,8 +197,25 @@ bool LCD_init(){
 	for (uint8_t var = 0; var < nb_io; ++var) {
 		HAL_GPIO_Init(gpio_table[var].port, &gpio_table[var].init_info);
 	}
+	// Bus timing from the core clock, counted by DWT
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	lcd_cycles_per_us = SystemCoreClock / 1000000;
+	lcd_setup_cycles = LCD_ns_to_cycles(LCD_SETUP_NS);
+	lcd_enable_pulse_cycles = LCD_ns_to_cycles(LCD_ENABLE_PULSE_NS);
+	lcd_enable_cycle_cycles = LCD_ns_to_cycles(LCD_ENABLE_CYCLE_NS);
+	lcd_read_delay_cycles = LCD_ns_to_cycles(LCD_READ_DELAY_NS);
+	lcd_last_enable = DWT->CYCCNT - lcd_enable_cycle_cycles;
+	lcd_data_crh_output = LCD_DATA_PORT->CRH;
+	lcd_enable_crh_output = LCD_CONTROL_PORT->CRH & LCD_ENABLE_CRH_MASK;
+	LCD_dma_init();
+	uint32_t start = DWT->CYCCNT;
 	LCD_begin();
 	LCD_graphic_mode();
+	SCH_Add_Task(LCD_render_task, 0, LCD_RENDER_INTERVAL);
+	utils_log_info("LCD_init: %d us, GDRAM clear left to the render task\r\n",
+					(DWT->CYCCNT - start) / lcd_cycles_per_us);
 	return true;
 }
 
@@ -133,22 +234,246 @@ void LCD_display_str(char * fmt, ...){
 	}
 }
 
-// Fixed size 32x32
-void LCD_draw_bitmap(uint8_t * bitmap_p){
-	LCD_clear_bitmap();
-	uint16_t x,y;
-	for (y = 0; y < 64; y++) {
-		for (x = 0; x < 128; x++) {
-			if (bitmap_p[(y / 8) * 128 + x] & (1 << (y % 8))) {
-				LCD_draw_pixel(x, y);
+/**
+ * Queue a frame of LCD_FRAME_SIZE bytes in native layout, it is pushed
+ * in slices by the render task and must stay valid until then.
+ * A frame still in flight is superseded: rendering restarts from the
+ * top with the new one, rows already on the glass are skipped by the diff.
+ */
+void LCD_draw_bitmap(const uint8_t * bitmap_p){
+	LCD_draw_region(bitmap_p, 0, LCD_HEIGHT);
+}
+
+/**
+ * Queue only screen rows [y_start, y_end) of a frame, for callers which
+ * know what they changed. Widened to the whole frame when the glass is
+ * not known or another frame is in flight.
+ */
+void LCD_draw_region(const uint8_t * bitmap_p, uint8_t y_start, uint8_t y_end){
+	if(!lcd_glass_valid){
+		y_start = 0;
+		y_end = LCD_HEIGHT;
+	}
+	if(lcd_render_row >= 0){
+		stats.superseded_count++;
+		if(bitmap_p != lcd_bitmap_buf){
+			y_start = 0;
+			y_end = LCD_HEIGHT;
+		}else{
+			y_start = y_start < lcd_render_start ? y_start : lcd_render_start;
+			y_end = y_end > lcd_render_end ? y_end : lcd_render_end;
+		}
+	}else{
+		stats.last_frame_bytes = 0;
+		stats.last_frame_commands = 0;
+		stats.last_frame_us = 0;
+	}
+	if(y_end > LCD_HEIGHT){
+		y_end = LCD_HEIGHT;
+	}
+	if(y_start >= y_end){
+		return;
+	}
+	lcd_bitmap_buf = bitmap_p;
+	lcd_render_start = y_start;
+	lcd_render_end = y_end;
+	lcd_render_row = y_start;
+	lcd_render_word = 0;
+}
+
+/**
+ * Write a text frame of LCD_TEXT_SIZE characters to DDRAM now. Each
+ * address holds a pair of half width characters, so only the pairs which
+ * differ from the glass are sent, one span per row. A few bytes against
+ * a GDRAM row per pixel line for the same text.
+ */
+void LCD_draw_text(const char * text_p){
+	bool basic = false;
+	int8_t first_pair;
+	int8_t last_pair;
+	size_t j;
+	for (uint8_t row = 0; row < LCD_TEXT_ROWS; row++) {
+		first_pair = -1;
+		last_pair = -1;
+		for (uint8_t pair = 0; pair < LCD_TEXT_COLUMNS / 2; pair++) {
+			j = row * LCD_TEXT_COLUMNS + pair * 2;
+			if(lcd_text_valid
+					&& text_p[j] == lcd_text_glass[j]
+					&& text_p[j + 1] == lcd_text_glass[j + 1]){
+				continue;
+			}
+			if(first_pair < 0){
+				first_pair = pair;
 			}
+			last_pair = pair;
+		}
+		if(first_pair < 0){
+			continue;
+		}
+		if(!basic){
+			// DDRAM is addressed with the basic instruction set
+			LCD_wait_ready(80);
+			LCD_send_command( LCD_FUNCTIONSET | display_function);
+			stats.text_bytes++;
+			basic = true;
 		}
+		LCD_text_span(text_p, row, first_pair, last_pair);
+	}
+	if(basic){
+		LCD_wait_ready(80);
+		LCD_send_command( LCD_FUNCTIONSETEXTENDED | display_function | LCD_GRAPHIC_ON);
+		stats.text_bytes++;
+	}
+	lcd_text_valid = true;
+}
+
+/**
+ * Overlays are XORed into the frame while it is sent, the frame itself
+ * is never modified. Showing or hiding one only queues its rows, the
+ * diff then sends the words under the rectangle.
+ */
+void LCD_set_overlay(uint8_t id, uint8_t x, uint8_t y, uint8_t width, uint8_t height){
+	LCD_overlay_t *overlay = &lcd_overlays[id];
+	if(overlay->on){
+		LCD_show_overlay(id, false);
+	}
+	overlay->x = x;
+	overlay->y = y;
+	overlay->width = width;
+	overlay->height = height;
+}
+
+void LCD_show_overlay(uint8_t id, bool on){
+	LCD_overlay_t *overlay = &lcd_overlays[id];
+	if(overlay->on == on){
+		return;
+	}
+	overlay->on = on;
+	if(lcd_bitmap_buf != NULL){
+		LCD_draw_region(lcd_bitmap_buf, overlay->y, overlay->y + overlay->height);
+	}
+}
+
+bool LCD_is_frame_complete(){
+	return lcd_render_row < 0;
+}
+
+// Push the rest of the queued frame now
+void LCD_flush(){
+	while(lcd_render_row >= 0){
+		LCD_render_rows(LCD_HEIGHT);
+	}
+}
+
+/**
+ * Force the next frame to be sent in full, e.g. when the glass
+ * may not match the shadow anymore.
+ */
+void LCD_invalidate(){
+	lcd_glass_valid = false;
+	lcd_text_valid = false;
+	if(lcd_render_row >= 0){
+		lcd_render_start = 0;
+		lcd_render_end = LCD_HEIGHT;
+		lcd_render_row = 0;
+		lcd_render_word = 0;
+	}
+}
+
+LCD_stats_t * LCD_get_stats(){
+	return &stats;
+}
+
+void LCD_reset_stats(){
+	memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Mirror the bus to a callback, e.g. the ST7920 model of Tools/lcdemu.
+ * Slows every transaction down, NULL turns it off.
+ */
+void LCD_set_trace(LCD_trace_t trace){
+	lcd_trace = trace;
+}
+
+/**
+ * Cycles spent on the bus per byte, HAL_GPIO_WritePin per line vs one
+ * BSRR store per port. Bytes go to GDRAM, so the next frame is sent in full.
+ */
+void LCD_benchmark(){
+	uint32_t start;
+	uint32_t gpio_cycles;
+	uint32_t bsrr_cycles;
+	LCD_flush();
+	LCD_send_command( LCD_SETGRAPHICADDRESS | 0); // y
+	LCD_delay_microseconds(80);
+	LCD_send_command( LCD_SETGRAPHICADDRESS | 0); // x
+	LCD_delay_microseconds(80);
+	start = DWT->CYCCNT;
+	for (uint32_t i = 0; i < LCD_BENCHMARK_BYTES; ++i) {
+		LCD_output_pins_gpio( 1u, 0u, i );
+		LCD_strobe();
 	}
-	LCD_render_bitmap();
+	gpio_cycles = DWT->CYCCNT - start;
+	start = DWT->CYCCNT;
+	for (uint32_t i = 0; i < LCD_BENCHMARK_BYTES; ++i) {
+		LCD_output_pins( 1u, 0u, i );
+		LCD_strobe();
+	}
+	bsrr_cycles = DWT->CYCCNT - start;
+	utils_log_info("LCD_benchmark: gpio %d cycles/byte, bsrr %d cycles/byte\r\n",
+					gpio_cycles / LCD_BENCHMARK_BYTES,
+					bsrr_cycles / LCD_BENCHMARK_BYTES);
+	// Full frame with each wait mode, resending what is on the glass
+	uint8_t mode = wait_mode;
+	LCD_set_wait_mode(LCD_WAIT_MODE_DELAY);
+	LCD_invalidate();
+	LCD_draw_bitmap(lcd_glass_buf);
+	LCD_flush();
+	utils_log_info("LCD_benchmark: delay frame %d us\r\n", stats.last_frame_us);
+	LCD_set_wait_mode(LCD_WAIT_MODE_BUSY_FLAG);
+	LCD_invalidate();
+	LCD_draw_bitmap(lcd_glass_buf);
+	LCD_flush();
+	utils_log_info("LCD_benchmark: busy flag frame %d us (mode %d)\r\n", stats.last_frame_us, wait_mode);
+	// CPU time against wall time per full frame for each transport
+	uint8_t prev_transport = transport;
+	for (uint8_t t = LCD_TRANSPORT_BITBANG; t <= LCD_TRANSPORT_DMA; t++) {
+		LCD_set_transport(t);
+		LCD_invalidate();
+		LCD_draw_bitmap(lcd_glass_buf);
+		start = HAL_GetTick();
+		LCD_flush();
+		utils_log_info("LCD_benchmark: %s frame cpu %d us, wall %d ms\r\n",
+						t == LCD_TRANSPORT_DMA ? "dma" : "bitbang",
+						stats.last_frame_us,
+						HAL_GetTick() - start);
+	}
+	LCD_set_transport(prev_transport);
+	LCD_set_wait_mode(mode);
+	LCD_invalidate();
+}
+
+/**
+ * LCD_TRANSPORT_DMA frees the CPU while GDRAM bytes are written, a span
+ * is addressed by the CPU and streamed at LCD_DMA_BYTE_US per byte.
+ * Commands and DDRAM text stay bit banged, they wait for the stream.
+ */
+void LCD_set_transport(uint8_t new_transport){
+	while(LCD_dma_busy());
+	transport = new_transport;
+}
+
+uint8_t LCD_get_transport(){
+	return transport;
 }
 
-void LCD_clear_bitmap(){
-	memset(lcd_bitmap_buf, 0, sizeof(lcd_bitmap_buf));
+void LCD_set_wait_mode(uint8_t mode){
+	wait_mode = mode;
+}
+
+uint8_t LCD_get_wait_mode(){
+	return wait_mode;
 }
 
 bool LCD_test(){
@@ -164,39 +489,40 @@ static void LCD_begin(){
 	display_control = LCD_DISPLAY_ON | LCD_CURSOR_OFF | LCD_BLINK_OFF;
 	display_function = LCD_INTERFACE_8BITS;
 
+	// Usually long gone by the time the other devices are initialised
+	while(HAL_GetTick() < LCD_POWER_ON_MS);
+
+	// Each instruction waits for the previous one, datasheet timing
 	LCD_send_command(
 	LCD_FUNCTIONSETEXTENDED | display_function | LCD_GRAPHIC_OFF);
-	LCD_delay(1);
+	LCD_wait_ready(80);
 	LCD_send_command( LCD_FUNCTIONSET | display_function);
-	LCD_delay(1);
+	LCD_wait_ready(80);
 
 	LCD_send_command( LCD_DISPLAYCLEAR);
-	LCD_delay(1);
+	LCD_wait_ready(LCD_CLEAR_US);
+	memset(lcd_text_glass, ' ', sizeof(lcd_text_glass));
+	lcd_text_valid = true;
 
 	LCD_send_command(
 	LCD_ENTRYMODE | LCD_CURSOR_MOVE_RIGHT | LCD_DISPLAY_NO_SHIFT);
-	LCD_delay(1);
+	LCD_wait_ready(80);
 
 	LCD_send_command( LCD_DISPLAYCONTROL | display_control);
-
-	LCD_delay_microseconds(160);
+	LCD_wait_ready(80);
 
 	LCD_send_command(
 	LCD_FUNCTIONSETEXTENDED | display_function | LCD_GRAPHIC_ON);
-	LCD_delay(1);
+	LCD_wait_ready(80);
 	LCD_send_command( LCD_FUNCTIONSCROLLORADDRESSSELECT);
-	LCD_delay(1);
-	for (uint8_t i = 0; i < 32; i++) {
-		LCD_send_command( LCD_SETGRAPHICADDRESS | i); // y
-		LCD_delay(1);
-		LCD_send_command( LCD_SETGRAPHICADDRESS | 0); // x
-		LCD_delay(1);
-
-		for (uint8_t j = 0; j < 32; j++) {
-			LCD_delay(1);
-			LCD_send_data(0u);
-		}
-	}
+	LCD_wait_ready(80);
+
+	// GDRAM keeps random content after power on. Clearing it is a full
+	// frame of zeros queued to the render task, superseded by the first
+	// screen when that comes earlier.
+	memset(lcd_glass_buf, 0, sizeof(lcd_glass_buf));
+	lcd_glass_valid = false;
+	LCD_draw_bitmap(lcd_glass_buf);
 }
 
 
@@ -255,32 +581,143 @@ static void LCD_display(){
 	LCD_send_command( LCD_DISPLAYCONTROL | display_control );
 }
 
-static void LCD_draw_pixel(int8_t x, int8_t y) {
-	if (y > 63 || y < 0) {
+static void LCD_render_task(){
+	LCD_render_rows(LCD_RENDER_ROWS_PER_SLICE);
+}
+
+static void LCD_render_rows(uint8_t max_rows){
+	if(lcd_render_row < 0){
 		return;
 	}
-	if (x / 8 + 16 > 32 || x < 0) {
-		return;
+	for (uint8_t i = 0; i < max_rows && lcd_render_row < lcd_render_end; i++) {
+		if(LCD_dma_busy()){
+			return;
+		}
+		if(!LCD_render_row(lcd_render_row)){
+			return;
+		}
+		lcd_render_row++;
+	}
+	// Complete once the last span is on the glass
+	if(lcd_render_row >= lcd_render_end && !LCD_dma_busy()){
+		lcd_render_row = -1;
+		// A region is only queued while the glass is known
+		lcd_glass_valid = true;
+		stats.frame_count++;
+		stats.total_bytes += stats.last_frame_bytes + stats.last_frame_commands;
+	}
+}
+
+/**
+ * Send only the 16-bit GDRAM words which differ from the glass.
+ * Changed words of a row are grouped in spans, each span costs one
+ * address setup, small gaps are resent instead of re-addressed.
+ * Screen rows 32..63 live in the right half of GDRAM rows 0..31.
+ * With the DMA transport a span is only started, the row resumes from
+ * lcd_render_word once it is on the glass. Returns true when the row is done.
+ */
+static bool LCD_render_row(uint8_t y){
+	int16_t first_word = -1;
+	int16_t last_word = -1;
+	for (uint8_t word = lcd_render_word; word < LCD_ROW_WORDS; word++) {
+		if(!LCD_is_word_dirty(y, word)){
+			continue;
+		}
+		if(first_word >= 0 && word - last_word - 1 > LCD_GDRAM_MERGE_GAP){
+			LCD_render_span(y, first_word, last_word);
+			if(transport == LCD_TRANSPORT_DMA){
+				lcd_render_word = last_word + 1;
+				return false;
+			}
+			first_word = -1;
+		}
+		if(first_word < 0){
+			first_word = word;
+		}
+		last_word = word;
+	}
+	if(first_word >= 0){
+		LCD_render_span(y, first_word, last_word);
+	}
+	lcd_render_word = 0;
+	return true;
+}
+
+static bool LCD_is_word_dirty(uint8_t y, uint8_t word){
+	size_t j = y * LCD_ROW_BYTES + word * 2;
+	if(!lcd_glass_valid){
+		return true;
 	}
-	if (y < 32)
-		lcd_bitmap_buf[x / 8][y] |= 1u << (8 - x % 8 - 1);
-	else
-		lcd_bitmap_buf[x / 8 + 16][y - 32] |= 1u << (8 - x % 8 - 1);
+	return LCD_frame_byte(y, word * 2) != lcd_glass_buf[j]
+			|| LCD_frame_byte(y, word * 2 + 1) != lcd_glass_buf[j + 1];
+}
+
+// Byte of the queued frame as it should look on the glass
+static uint8_t LCD_frame_byte(uint8_t y, uint8_t column){
+	return lcd_bitmap_buf[y * LCD_ROW_BYTES + column] ^ LCD_overlay_mask(y, column);
+}
 
+static uint8_t LCD_overlay_mask(uint8_t y, uint8_t column){
+	const LCD_overlay_t *overlay;
+	uint8_t mask = 0;
+	uint8_t left = column * 8;
+	uint8_t start;
+	uint8_t end;
+	for (uint8_t i = 0; i < LCD_OVERLAY_MAX; i++) {
+		overlay = &lcd_overlays[i];
+		if(!overlay->on || y < overlay->y || y >= overlay->y + overlay->height){
+			continue;
+		}
+		start = overlay->x > left ? overlay->x : left;
+		end = overlay->x + overlay->width < left + 8 ? overlay->x + overlay->width : left + 8;
+		if(start < end){
+			mask |= (0xFF >> (start - left)) & (uint8_t)(0xFF << (left + 8 - end));
+		}
+	}
+	return mask;
 }
 
-static void LCD_render_bitmap(){
-	uint8_t startX = 0;
-	uint8_t cantX = 32;
-	for (uint8_t i = 0; i < 32; i++) {  // iterate for 'y' axis
-		LCD_send_command( LCD_SETGRAPHICADDRESS | i); // y
-		LCD_delay_microseconds(80);
-		LCD_send_command( LCD_SETGRAPHICADDRESS | startX); // x
-		for (uint8_t j = 2 * startX; j < cantX; j++) {
-			LCD_delay_microseconds(80);
-			LCD_send_data(lcd_bitmap_buf[j][i]);
+static void LCD_render_span(uint8_t y, uint8_t first_word, uint8_t last_word){
+	uint32_t start = DWT->CYCCNT;
+	size_t row_start = y * LCD_ROW_BYTES;
+	uint8_t count = 0;
+	LCD_wait_ready(80);
+	LCD_send_command( LCD_SETGRAPHICADDRESS | (y % LCD_GDRAM_ROWS)); // y
+	LCD_wait_ready(80);
+	LCD_send_command( LCD_SETGRAPHICADDRESS | ((y / LCD_GDRAM_ROWS) * LCD_ROW_WORDS + first_word)); // x
+	stats.last_frame_commands += 2;
+	for (uint8_t column = first_word * 2; column <= last_word * 2 + 1; column++) {
+		lcd_glass_buf[row_start + column] = LCD_frame_byte(y, column);
+		stats.last_frame_bytes++;
+		if(transport == LCD_TRANSPORT_DMA){
+			lcd_dma_buf[count++] = ((uint32_t)0xFF << (LCD_DATA_SHIFT + 16))
+									| ((uint32_t)lcd_glass_buf[row_start + column] << LCD_DATA_SHIFT);
+			if(lcd_trace != NULL){
+				lcd_trace(true, lcd_glass_buf[row_start + column]);
+			}
+			continue;
 		}
-		LCD_delay_microseconds(40);
+		LCD_wait_ready(80);
+		LCD_send_data(lcd_glass_buf[row_start + column]);
+	}
+	if(count > 0){
+		LCD_dma_start(count);
+	}
+	uint32_t us = (DWT->CYCCNT - start) / lcd_cycles_per_us;
+	stats.last_frame_us += us;
+	stats.total_us += us;
+}
+
+static void LCD_text_span(const char * text_p, uint8_t row, uint8_t first_pair, uint8_t last_pair){
+	size_t row_start = row * LCD_TEXT_COLUMNS;
+	LCD_wait_ready(80);
+	LCD_set_cursor(first_pair, row);
+	stats.text_bytes++;
+	for (size_t j = row_start + first_pair * 2; j <= row_start + last_pair * 2 + 1; j++) {
+		LCD_wait_ready(80);
+		LCD_send_data(text_p[j]);
+		lcd_text_glass[j] = text_p[j];
+		stats.text_bytes++;
 	}
 }
 
@@ -314,6 +751,14 @@ static void LCD_set_cursor( uint8_t col, uint8_t row ){
 }
 
 static void LCD_output_pins( uint8_t rs, uint8_t rw, uint8_t data ){
+	LCD_CONTROL_PORT->BSRR = (rs ? LCD_RS_PIN : (uint32_t)LCD_RS_PIN << 16)
+							| (rw ? LCD_RW_PIN : (uint32_t)LCD_RW_PIN << 16);
+	// Set bits win over reset bits in the same store
+	LCD_DATA_PORT->BSRR = ((uint32_t)0xFF << (LCD_DATA_SHIFT + 16)) | ((uint32_t)data << LCD_DATA_SHIFT);
+}
+
+// Per pin version, only kept for LCD_benchmark
+static void LCD_output_pins_gpio( uint8_t rs, uint8_t rw, uint8_t data ){
 	HAL_GPIO_WritePin(gpio_table[LCD_RS].port, gpio_table[LCD_RS].init_info.Pin, rs);
 	HAL_GPIO_WritePin(gpio_table[LCD_RW].port, gpio_table[LCD_RW].init_info.Pin, rw);
 	HAL_GPIO_WritePin(gpio_table[LCD_D7].port, gpio_table[LCD_D7].init_info.Pin, (data >> 7) & 0x01);
@@ -327,25 +772,145 @@ static void LCD_output_pins( uint8_t rs, uint8_t rw, uint8_t data ){
 }
 
 static void LCD_strobe(){
-	HAL_GPIO_WritePin(gpio_table[LCD_ENABLE].port, gpio_table[LCD_ENABLE].init_info.Pin, SET);
-	LCD_delay_microseconds(1);
-	HAL_GPIO_WritePin(gpio_table[LCD_ENABLE].port, gpio_table[LCD_ENABLE].init_info.Pin, RESET);
+	LCD_delay_cycles(lcd_setup_cycles);
+	while(DWT->CYCCNT - lcd_last_enable < lcd_enable_cycle_cycles);
+	lcd_last_enable = DWT->CYCCNT;
+	LCD_CONTROL_PORT->BSRR = LCD_ENABLE_PIN;
+	LCD_delay_cycles(lcd_enable_pulse_cycles);
+	LCD_CONTROL_PORT->BSRR = (uint32_t)LCD_ENABLE_PIN << 16;
+}
+
+/**
+ * Wait until the controller can take the next byte: poll BF or,
+ * in LCD_WAIT_MODE_DELAY, wait the given worst case time.
+ */
+static void LCD_wait_ready(size_t us){
+	// The bus belongs to the DMA until the span is written
+	while(LCD_dma_busy());
+	if(wait_mode == LCD_WAIT_MODE_BUSY_FLAG){
+		if(LCD_wait_busy_flag()){
+			return;
+		}
+		// BF never cleared, RW or D7 not wired -> keep fixed delays
+		wait_mode = LCD_WAIT_MODE_DELAY;
+		utils_log_warn("LCD busy flag timeout, use fixed delays\r\n");
+	}
+	LCD_delay_microseconds(us);
+}
+
+// Read BF with RS low and RW high, the data port is an input meanwhile
+static bool LCD_wait_busy_flag(){
+	bool busy = true;
+	uint32_t start = DWT->CYCCNT;
+	uint32_t timeout = LCD_BUSY_TIMEOUT_US * lcd_cycles_per_us;
+	LCD_DATA_PORT->CRH = LCD_DATA_CRH_INPUT;
+	LCD_CONTROL_PORT->BSRR = ((uint32_t)LCD_RS_PIN << 16) | LCD_RW_PIN;
+	LCD_delay_cycles(lcd_setup_cycles);
+	while(busy && DWT->CYCCNT - start < timeout){
+		while(DWT->CYCCNT - lcd_last_enable < lcd_enable_cycle_cycles);
+		lcd_last_enable = DWT->CYCCNT;
+		LCD_CONTROL_PORT->BSRR = LCD_ENABLE_PIN;
+		LCD_delay_cycles(lcd_read_delay_cycles);
+		busy = (LCD_DATA_PORT->IDR & LCD_D7_PIN) != 0;
+		LCD_CONTROL_PORT->BSRR = (uint32_t)LCD_ENABLE_PIN << 16;
+	}
+	LCD_CONTROL_PORT->BSRR = (uint32_t)LCD_RW_PIN << 16;
+	LCD_DATA_PORT->CRH = lcd_data_crh_output;
+	return !busy;
+}
+
+static void LCD_dma_init(){
+	uint32_t clock = HAL_RCC_GetPCLK2Freq();
+	uint32_t period;
+	// APB2 timers run at twice PCLK2 when it is divided
+	if((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1){
+		clock *= 2;
+	}
+	period = clock / 1000000 * LCD_DMA_BYTE_US;
+	RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+	RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+	LCD_DMA_TIMER->CR1 = TIM_CR1_OPM;
+	LCD_DMA_TIMER->PSC = 0;
+	LCD_DMA_TIMER->ARR = period - 1;
+	// Data store after E fell, E high for the last LCD_ENABLE_PULSE_NS
+	LCD_DMA_TIMER->CCR1 = (clock / 1000000) * LCD_DMA_DATA_DELAY_NS / 1000;
+	LCD_DMA_TIMER->CCR3 = period - (clock / 1000000) * LCD_ENABLE_PULSE_NS / 1000;
+	// CC3E clear: CH3N follows OC3REF, not its complement. Forced
+	// inactive keeps E low until a span starts
+	LCD_DMA_TIMER->CCMR2 = TIM_CCMR2_OC3M_2;
+	LCD_DMA_TIMER->CCER = TIM_CCER_CC3NE;
+	LCD_DMA_TIMER->BDTR = TIM_BDTR_MOE;
+	LCD_DMA_TIMER->DIER = TIM_DIER_CC1DE;
+	LCD_DMA_CHANNEL->CPAR = (uint32_t)(uintptr_t)&LCD_DATA_PORT->BSRR;
+}
+
+static void LCD_dma_start(uint8_t count){
+	LCD_CONTROL_PORT->BSRR = LCD_RS_PIN | ((uint32_t)LCD_RW_PIN << 16);
+	LCD_DMA_CHANNEL->CCR = 0;
+	DMA1->IFCR = LCD_DMA_FLAGS;
+	LCD_DMA_CHANNEL->CMAR = (uint32_t)(uintptr_t)lcd_dma_buf;
+	LCD_DMA_CHANNEL->CNDTR = count;
+	LCD_DMA_CHANNEL->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_EN;
+	// count periods, then one pulse mode clears CEN
+	LCD_DMA_TIMER->RCR = count - 1;
+	LCD_DMA_TIMER->EGR = TIM_EGR_UG;
+	LCD_DMA_TIMER->SR = 0;
+	// PWM mode 2: E rises at CCR3 and falls at the update, the last one
+	// leaves CNT at 0 with E low
+	LCD_DMA_TIMER->CCMR2 = TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 | TIM_CCMR2_OC3M_0;
+	LCD_CONTROL_PORT->CRH = (LCD_CONTROL_PORT->CRH & ~LCD_ENABLE_CRH_MASK) | LCD_ENABLE_CRH_AF;
+	lcd_dma_active = true;
+	LCD_DMA_TIMER->CR1 |= TIM_CR1_CEN;
+}
+
+// Polled, gives the pins back to the bit banged path when the span is done
+static bool LCD_dma_busy(){
+	if(!lcd_dma_active){
+		return false;
+	}
+	if(LCD_DMA_TIMER->CR1 & TIM_CR1_CEN){
+		return true;
+	}
+	// E is already low, back to GPIO without an edge
+	LCD_DMA_TIMER->CCMR2 = TIM_CCMR2_OC3M_2;
+	LCD_CONTROL_PORT->BSRR = (uint32_t)LCD_ENABLE_PIN << 16;
+	LCD_CONTROL_PORT->CRH = (LCD_CONTROL_PORT->CRH & ~LCD_ENABLE_CRH_MASK) | lcd_enable_crh_output;
+	LCD_DMA_CHANNEL->CCR = 0;
+	DMA1->IFCR = LCD_DMA_FLAGS;
+	lcd_dma_active = false;
+	lcd_last_enable = DWT->CYCCNT;
+	return false;
 }
 
 static void  LCD_send_command( uint8_t cmd ){
 	LCD_output_pins( 0u, 0u, cmd );
 	LCD_strobe();
+	if(lcd_trace != NULL){
+		lcd_trace(false, cmd);
+	}
 }
 
 static void LCD_send_data( char d ){
 	LCD_output_pins( 1u, 0u, d );
 	LCD_strobe();
+	if(lcd_trace != NULL){
+		lcd_trace(true, d);
+	}
 }
 
 
 static bool LCD_delay_microseconds(size_t us){
-	size_t _us = us * 10;
-	while(_us--);
+	LCD_delay_cycles(us * lcd_cycles_per_us);
+	return true;
+}
+
+static void LCD_delay_cycles(uint32_t cycles){
+	uint32_t start = DWT->CYCCNT;
+	while(DWT->CYCCNT - start < cycles);
+}
+
+static uint32_t LCD_ns_to_cycles(uint32_t ns){
+	return (lcd_cycles_per_us * ns + 999) / 1000;
 }
 
 static bool LCD_delay(size_t ms){
@@ -13,6 +13,7 @@
 #include "Hal/i2c.h"
 
 #define DS1307_ADDRESS	0x68
+#define DS1307_NVRAM_ADDRESS	0x08
 
 
 static uint8_t RTC_dec_to_bcd(uint8_t num);
@@ -55,6 +56,24 @@ void RTC_set_time(RTC_t *rtc){
 	write_data[1] = RTC_dec_to_bcd(rtc->second);
 	I2C_write(DS1307_ADDRESS  << 1, write_data, 2);
 }
+/**
+ * NVRAM has no write cycle time and no wear limit,
+ * it keeps its content as long as the backup battery is present
+ */
+bool RTC_read_nvram(uint8_t offset, uint8_t *data, size_t data_len){
+	if(offset + data_len > RTC_NVRAM_SIZE){
+		return false;
+	}
+	return I2C_mem_read(DS1307_ADDRESS << 1, DS1307_NVRAM_ADDRESS + offset, I2C_MEMADD_SIZE_8BIT, data, data_len);
+}
+
+bool RTC_write_nvram(uint8_t offset, uint8_t *data, size_t data_len){
+	if(offset + data_len > RTC_NVRAM_SIZE){
+		return false;
+	}
+	return I2C_mem_write(DS1307_ADDRESS << 1, DS1307_NVRAM_ADDRESS + offset, I2C_MEMADD_SIZE_8BIT, data, data_len);
+}
+
 void RTC_test(){
 	RTC_t rtc = {
 		.second = 20,
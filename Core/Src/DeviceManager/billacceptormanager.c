@@ -7,6 +7,7 @@
 #include "main.h"
 #include "string.h"
 #include "config.h"
+#include "ledger.h"
 #include "DeviceManager/billacceptormanager.h"
 #include "Device/billacceptor.h"
 #include "Device/eeprom.h"
@@ -241,6 +242,8 @@ static void BILLACCEPTORMNG_bill_accepted(){
 			amount += bill_mapping[bill_type_accepted];
 			// Update total amount
 			config->total_amount += bill_mapping[bill_type_accepted];
+			// Ledger first, LEDGER_init applies it when the config write is cut
+			LEDGER_append_bill(last_bill_accepted, amount);
 			// Save it to EEPROM
 			BILLACCEPTOR_save_amount_to_eeprom(amount, config->total_amount);
 			// LCD display Bill detected and Bill value
@@ -0,0 +1,265 @@
+/*
+ * lcdimages.c
+ *
+ * Generated by Tools/lcdimage/lcdimage.py, do not edit.
+ */
+
+#include "DeviceManager/lcdimages.h"
+
+// card_empty.pbm, 128x64, 385 bytes
+static const uint8_t card_empty_data[] = {
+	0x81,0x00,0x81,0x00,0xEC,0x00,0x01,0x01,0xC0,0xF3,0x00,0x01,0x01,0x80,0xFB,0x00,
+	0x00,0xF0,0xFA,0x00,0x00,0x73,0xFD,0x00,0x03,0xF8,0x00,0x01,0x30,0xFE,0x00,0x04,
+	0x07,0xF0,0x7F,0x00,0xF3,0xFD,0x00,0x03,0x38,0x00,0x01,0x10,0xFE,0x00,0x04,0x01,
+	0xC0,0x1C,0x00,0xDA,0xFD,0x00,0x00,0x38,0xFF,0x00,0x00,0x30,0xFE,0x00,0x09,0x01,
+	0xC0,0x1C,0x01,0x88,0x07,0x00,0x01,0xC0,0x38,0xFF,0x00,0x00,0x20,0xFE,0x00,0x09,
+	0x01,0xC0,0x1C,0x03,0x0C,0x07,0x00,0x01,0xC0,0x38,0xFF,0x00,0x00,0x40,0xFE,0x00,
+	0x09,0x01,0xC0,0x1C,0x00,0x04,0x07,0x00,0x01,0xC0,0x38,0xFF,0x00,0x00,0x40,0xFE,
+	0x00,0x02,0x01,0xC0,0x1C,0xFF,0x00,0x04,0x07,0x00,0x01,0xC0,0x38,0xFB,0x00,0x0C,
+	0x01,0xC0,0x1C,0x00,0xF8,0x0F,0xF8,0x03,0xFE,0x38,0xF0,0x01,0xF0,0xFE,0x00,0x0C,
+	0x01,0xC0,0x1C,0x03,0x8E,0x1F,0xF8,0x07,0xFE,0x3B,0xF8,0x07,0x1C,0xFE,0x00,0x02,
+	0x01,0xC0,0x1C,0xFE,0x07,0x04,0x00,0x01,0xC0,0x3E,0x3C,0xFF,0x0E,0xFE,0x00,0x03,
+	0x01,0xC0,0x1C,0x06,0xFF,0x07,0x06,0x00,0x01,0xC0,0x3C,0x1C,0x0C,0x0E,0xFE,0x00,
+	0x09,0x01,0xFF,0xFC,0x0E,0x03,0x07,0x00,0x01,0xC0,0x38,0xFF,0x1C,0x00,0x06,0xFE,
+	0x00,0x09,0x01,0xFF,0xFC,0x0E,0x03,0x87,0x00,0x01,0xC0,0x38,0xFF,0x1C,0x00,0x07,
+	0xFE,0x00,0x0C,0x01,0xC0,0x1C,0x0F,0xFF,0x87,0x00,0x01,0xC0,0x38,0x1C,0x1F,0xFF,
+	0xFE,0x00,0x09,0x01,0xC0,0x1C,0x0E,0x00,0x07,0x00,0x01,0xC0,0x38,0xFF,0x1C,0xFD,
+	0x00,0x09,0x01,0xC0,0x1C,0x0E,0x00,0x07,0x00,0x01,0xC0,0x38,0xFF,0x1C,0xFD,0x00,
+	0x09,0x01,0xC0,0x1C,0x0E,0x00,0x07,0x00,0x01,0xC0,0x38,0xFF,0x1C,0xFD,0x00,0x09,
+	0x01,0xC0,0x1C,0x0E,0x00,0x07,0x00,0x01,0xC0,0x38,0xFF,0x1C,0xFD,0x00,0x09,0x01,
+	0xC0,0x1C,0x0E,0x00,0x07,0x00,0x01,0xC0,0x38,0xFF,0x1C,0xFD,0x00,0x0C,0x01,0xC0,
+	0x1C,0x07,0x01,0x07,0x00,0x01,0xC0,0x38,0x1C,0x0E,0x02,0xFE,0x00,0x0C,0x01,0xC0,
+	0x1C,0x07,0x86,0x07,0x88,0x01,0xE2,0x38,0x1C,0x0F,0x0C,0xFE,0x00,0x0C,0x01,0xC0,
+	0x1C,0x03,0xFC,0x03,0xF0,0x00,0xFC,0x38,0x1C,0x07,0xF8,0xFE,0x00,0x0C,0x07,0xF0,
+	0x7F,0x00,0xF8,0x01,0xE0,0x00,0x78,0xFE,0x3F,0x01,0xF0,0x81,0x00,0x81,0x00,0x9F,
+	0x00
+};
+const LCDIMG_t LCDIMG_card_empty = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(card_empty_data),
+		.data = card_empty_data
+};
+
+// card_error.pbm, 128x64, 395 bytes
+static const uint8_t card_error_data[] = {
+	0x81,0x00,0x81,0x00,0xE6,0x00,0x01,0x07,0x8C,0xF3,0x00,0x01,0x0F,0xF8,0xF3,0x00,
+	0x01,0x18,0xF0,0xED,0x00,0x05,0x01,0xF8,0x07,0xF0,0x03,0xC0,0xFE,0x00,0x03,0x3C,
+	0x03,0xC0,0x0F,0xFE,0x00,0x05,0x01,0xF8,0x07,0xF0,0x07,0x80,0xFE,0x00,0x03,0x3C,
+	0x07,0xE0,0x0F,0xFE,0x00,0x04,0x01,0xF8,0x07,0xE0,0x0F,0xFD,0x00,0x03,0x78,0x0E,
+	0xE0,0x1E,0xFE,0x00,0x04,0x03,0xF8,0x0F,0xE0,0x1E,0xFD,0x00,0x03,0x78,0x1C,0x70,
+	0x1E,0xFE,0x00,0x03,0x03,0xDC,0x0F,0xE0,0xFC,0x00,0x00,0x78,0xFB,0x00,0x03,0x03,
+	0xDC,0x1F,0xE0,0xFC,0x00,0x00,0x78,0xFB,0x00,0x0C,0x03,0xDC,0x1D,0xE0,0x3F,0x03,
+	0xC0,0x78,0x00,0xF0,0x0F,0xC0,0x3C,0xFE,0x00,0x0C,0x03,0xDC,0x3D,0xC0,0xFF,0xC3,
+	0xC0,0xF8,0x00,0xF0,0x3F,0xF0,0x3C,0xFE,0x00,0x0C,0x07,0xDC,0x3B,0xC1,0xFF,0xE3,
+	0xC0,0xF0,0x00,0xF0,0xFF,0xF8,0x3C,0xFE,0x00,0x03,0x07,0x9C,0x7B,0xC3,0xFF,0xE3,
+	0x06,0xC1,0xF0,0x00,0xF0,0xF8,0x78,0x3C,0xFE,0x00,0x04,0x07,0x9C,0x73,0xC3,0xC1,
+	0xFF,0xE1,0x03,0xE0,0x00,0xF1,0xF0,0xFF,0x3C,0xFE,0x00,0x0C,0x07,0x9C,0xF3,0x80,
+	0x01,0xE1,0xE3,0xC0,0x01,0xE1,0xE0,0x3C,0x78,0xFE,0x00,0x0C,0x07,0x9C,0xE7,0x80,
+	0x1F,0xE1,0xE3,0xC0,0x01,0xE3,0xE0,0x3C,0x78,0xFE,0x00,0x0C,0x07,0x9C,0xE7,0x83,
+	0xFF,0xC1,0xE3,0x80,0x01,0xE3,0xC0,0x3C,0x78,0xFE,0x00,0x0C,0x0F,0x1D,0xE7,0x87,
+	0xFF,0xC1,0xE7,0x80,0x01,0xE3,0xC0,0x3C,0x78,0xFE,0x00,0x0C,0x0F,0x1D,0xC7,0x8F,
+	0xE3,0xC1,0xE7,0x00,0x03,0xE3,0xC0,0x7C,0xF8,0xFE,0x00,0x0C,0x0F,0x1F,0xCF,0x0F,
+	0x03,0xC1,0xEF,0x00,0x03,0xC3,0xC0,0x78,0xF0,0xFE,0x00,0x0C,0x0F,0x1F,0x8F,0x0F,
+	0x07,0x81,0xEE,0x00,0x03,0xC3,0xE0,0xF8,0xF0,0xFE,0x00,0x02,0x0F,0x1F,0x8F,0xFF,
+	0x0F,0x05,0x80,0xFE,0x00,0x03,0xC1,0xF1,0xFF,0xF0,0xFE,0x00,0x01,0x1E,0x1F,0xFF,
+	0x0F,0x08,0xFF,0x80,0xFC,0x00,0x03,0xC1,0xFF,0xE0,0xF0,0xFE,0x00,0x0C,0x1E,0x1F,
+	0x1E,0x07,0xFF,0x80,0xFC,0x00,0x07,0x80,0xFF,0xC1,0xE0,0xFE,0x00,0xFE,0x1E,0x09,
+	0x03,0xE7,0x80,0xF8,0x00,0x07,0x80,0x3F,0x01,0xE0,0xF8,0x00,0x00,0xF8,0xF3,0x00,
+	0x01,0x01,0xF0,0xF3,0x00,0x01,0x03,0xF0,0xF3,0x00,0x01,0x1F,0xE0,0xF3,0x00,0x01,
+	0x1F,0xC0,0xF3,0x00,0x01,0x1F,0x80,0x81,0x00,0x89,0x00
+};
+const LCDIMG_t LCDIMG_card_error = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(card_error_data),
+		.data = card_error_data
+};
+
+// card_lower.pbm, 128x64, 349 bytes
+static const uint8_t card_lower_data[] = {
+	0x81,0x00,0x81,0x00,0xD3,0x00,0x00,0x3C,0xF5,0x00,0x03,0x01,0xC0,0x00,0x26,0xFD,
+	0x00,0x00,0x40,0xFE,0x00,0x00,0x02,0xFE,0x00,0x03,0x01,0xC0,0x00,0x26,0xFF,0x00,
+	0x02,0x3F,0x80,0xE0,0xFE,0x00,0x00,0x07,0xFE,0x00,0x03,0x01,0xC0,0x00,0x04,0xFF,
+	0x00,0x02,0xFF,0xF0,0x70,0xFE,0x00,0x00,0x0E,0xFE,0x00,0x08,0x01,0xC0,0x00,0x08,
+	0x00,0x01,0xC0,0xE0,0x3C,0xFE,0x00,0x00,0x3C,0xFE,0x00,0x08,0x01,0xC0,0x00,0x10,
+	0x00,0x03,0x80,0x20,0x08,0xFE,0x00,0x05,0x10,0x1C,0x00,0x07,0x01,0xC0,0xFE,0x00,
+	0x00,0x07,0xFA,0x00,0x04,0x1C,0x00,0x07,0x01,0xC0,0xFE,0x00,0x00,0x06,0xFA,0x00,
+	0x08,0x1C,0x00,0x07,0x01,0xC0,0x00,0x3E,0x00,0x0E,0xFF,0x00,0x23,0x7E,0x07,0x3E,
+	0x00,0x1C,0xFF,0xC0,0x3F,0xF1,0xDF,0x00,0xE3,0x80,0x0E,0x00,0x01,0xFF,0x07,0xFF,
+	0x00,0x1C,0xFF,0xC0,0x3F,0xF1,0xFF,0x81,0xC1,0x80,0x0E,0x00,0x03,0x83,0x87,0x83,
+	0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xE1,0xC1,0x81,0xC0,0x0E,0x00,0x03,0x01,0x87,
+	0x03,0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xC1,0xC3,0x81,0xC0,0x0E,0x00,0x07,0x01,
+	0xC7,0x03,0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xC1,0xC3,0xFF,0xC0,0x0E,0x00,0x07,
+	0x01,0xC7,0x03,0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xC1,0xC3,0x80,0x00,0x0E,0x00,
+	0x07,0x01,0xC7,0x03,0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xC1,0xC3,0x80,0x00,0x06,
+	0x00,0x07,0x01,0xC7,0x03,0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xC1,0xC3,0x80,0x00,
+	0x07,0x00,0x07,0x01,0xC7,0x03,0x80,0xFF,0x1C,0x0D,0x00,0x07,0x01,0xC1,0xC3,0x80,
+	0x00,0x03,0x80,0x03,0x01,0x87,0x03,0x80,0xFF,0x1C,0x02,0x00,0x07,0x01,0xFF,0xC1,
+	0x08,0xC0,0x40,0x03,0xC0,0xF3,0x83,0x87,0x03,0x80,0xFF,0x1C,0x02,0x00,0x07,0x01,
+	0xFF,0xC1,0x10,0xE1,0x80,0x00,0xFF,0xE1,0xFF,0x07,0x03,0x80,0x1C,0x0F,0xC0,0x03,
+	0xF1,0xC1,0xC0,0xFF,0xFF,0x00,0x0D,0x3F,0x80,0xFC,0x07,0x03,0x80,0x1C,0x07,0x80,
+	0x01,0xE1,0xC1,0xC0,0x7E,0x81,0x00,0x81,0x00,0x81,0x00,0x00,0x00
+};
+const LCDIMG_t LCDIMG_card_lower = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(card_lower_data),
+		.data = card_lower_data
+};
+
+// logo.pbm, 128x64, 620 bytes
+static const uint8_t logo_data[] = {
+	0xF7,0x00,0x01,0x07,0xC0,0xF3,0x00,0x01,0x1F,0xF0,0xF3,0x00,0x01,0x3F,0xF8,0xF3,
+	0x00,0x01,0x7F,0xFC,0xF3,0x00,0x01,0x7F,0xF8,0xF3,0x00,0x01,0xFF,0xC0,0xF7,0x00,
+	0x01,0x03,0xF8,0xFF,0x00,0x01,0xFE,0x41,0xF7,0x00,0x01,0x0F,0xFC,0xFF,0x00,0x01,
+	0xFE,0x01,0xF7,0x00,0x01,0x1F,0xFE,0xFF,0x00,0x01,0xBF,0x01,0xF7,0x00,0x01,0x3F,
+	0xFE,0xFF,0x00,0x01,0x3F,0x01,0xF7,0x00,0x01,0x7F,0xFF,0xFF,0x00,0x01,0x0F,0x81,
+	0xF7,0x00,0xFF,0xFF,0xFF,0x00,0x00,0x83,0xF7,0x00,0x00,0x01,0xFF,0xFF,0xFF,0x00,
+	0x01,0x20,0x02,0xF8,0x00,0x00,0x03,0xFF,0xFF,0x02,0x80,0x00,0x50,0xF7,0x00,0x00,
+	0x03,0xFF,0xFF,0x03,0x80,0x00,0x28,0x08,0xF8,0x00,0x00,0x07,0xFF,0xFF,0x03,0x80,
+	0x00,0x0C,0x30,0xF8,0x00,0x00,0x0F,0xFF,0xFF,0x00,0x80,0xF5,0x00,0x00,0x0F,0xFF,
+	0xFF,0x00,0x80,0xF5,0x00,0x03,0x1F,0xFD,0xFF,0x80,0xF5,0x00,0x03,0x1F,0xF9,0xFF,
+	0x80,0xF5,0x00,0x03,0x3F,0xF1,0xFF,0x80,0xF5,0x00,0x03,0x3F,0xF1,0xFF,0x80,0xF5,
+	0x00,0x03,0x7F,0xE1,0xFF,0x80,0xF5,0x00,0x03,0x7F,0xC1,0xFF,0x80,0xF5,0x00,0x03,
+	0xFF,0x81,0xFF,0x80,0xF5,0x00,0x05,0xFF,0x81,0xFF,0x80,0x00,0x1F,0xF8,0x00,0x07,
+	0x01,0xFF,0x01,0xFF,0x80,0x00,0x7F,0x80,0xF9,0x00,0x07,0x01,0xFF,0x01,0xFF,0x80,
+	0x00,0x7F,0xC0,0xF9,0x00,0x07,0x03,0xFE,0x01,0xFF,0x80,0x01,0xFF,0xE0,0xF9,0x00,
+	0x07,0x03,0xFC,0x01,0xFF,0x80,0x01,0xFF,0xE0,0xF9,0x00,0x07,0x03,0xF8,0x03,0xFF,
+	0x80,0x03,0xFF,0xF0,0xF9,0x00,0x07,0x07,0xF8,0x03,0xFF,0x80,0x07,0xFB,0xF0,0xF9,
+	0x00,0x07,0x07,0xF0,0x03,0xFF,0x80,0x0F,0xF1,0xF0,0xF9,0x00,0x07,0x0F,0xF0,0x03,
+	0xFF,0x80,0x1F,0xF1,0xF0,0xF9,0x00,0x07,0x0F,0xE0,0x03,0xFF,0x80,0x1F,0xE1,0xF8,
+	0xF9,0x00,0x07,0x0F,0xC0,0x03,0xFF,0x80,0x3F,0xC0,0xF8,0xF9,0x00,0x07,0x1F,0xC0,
+	0x03,0xFF,0x80,0x7F,0xC0,0xF8,0xF9,0x00,0x07,0x1F,0x80,0x03,0xFF,0x80,0x7F,0x80,
+	0xF8,0xF9,0x00,0x07,0x3F,0x80,0x03,0xFF,0x80,0xFF,0x80,0xF8,0xF9,0x00,0x07,0x3F,
+	0x00,0x03,0xFF,0x81,0xFF,0x00,0x78,0xF9,0x00,0x07,0x7F,0x00,0x03,0xFF,0x81,0xFF,
+	0x00,0x78,0xF9,0x00,0x07,0x7E,0x00,0x03,0xFF,0x83,0xFE,0x00,0x78,0xF9,0x00,0x07,
+	0x7E,0x00,0x03,0xFF,0x83,0xFE,0x00,0x78,0xF9,0x00,0x07,0xFC,0x00,0x03,0xFF,0x87,
+	0xFC,0x00,0x78,0xF9,0x00,0x07,0xFC,0x00,0x03,0xFF,0x8F,0xFC,0x00,0x78,0xFA,0x00,
+	0x08,0x01,0xF8,0x00,0x03,0xFF,0x8F,0xF8,0x00,0x38,0xFA,0x00,0x08,0x01,0xF8,0x00,
+	0x01,0xFF,0x9F,0xF8,0x00,0x38,0xFA,0x00,0x08,0x01,0xF8,0x00,0x01,0xFF,0x9F,0xF0,
+	0x00,0x38,0xFA,0x00,0x08,0x03,0xF0,0x00,0x01,0xFF,0xBF,0xF0,0x00,0x38,0xFA,0x00,
+	0x03,0x03,0xE0,0x00,0x01,0xFF,0xFF,0x02,0xE0,0x00,0x38,0xFA,0x00,0x03,0x07,0xE0,
+	0x00,0x01,0xFF,0xFF,0x02,0xC0,0x00,0x38,0xFA,0x00,0x03,0x07,0xC0,0x00,0x01,0xFF,
+	0xFF,0x02,0xC0,0x00,0x38,0xFA,0x00,0x03,0x0F,0x80,0x00,0x01,0xFF,0xFF,0x02,0x80,
+	0x00,0x18,0xFA,0x00,0x00,0x0F,0xFE,0x00,0xFF,0xFF,0x02,0x80,0x00,0x18,0xFA,0x00,
+	0x00,0x1F,0xFE,0x00,0xFF,0xFF,0xFF,0x00,0x00,0x18,0xFA,0x00,0x00,0x1E,0xFE,0x00,
+	0x01,0xFF,0xFE,0xFF,0x00,0x00,0x18,0xFA,0x00,0x00,0x3C,0xFE,0x00,0x01,0xFF,0xFE,
+	0xFF,0x00,0x00,0x18,0xFA,0x00,0x00,0x38,0xFE,0x00,0x01,0x7F,0xFC,0xFF,0x00,0x00,
+	0x10,0xFA,0x00,0x00,0x78,0xFE,0x00,0x01,0x7F,0xF8,0xF7,0x00,0x00,0x60,0xFE,0x00,
+	0x01,0x3F,0xF0,0xF7,0x00,0x00,0xC0,0xFE,0x00,0x01,0x1F,0xE0,0xF8,0x00,0x01,0x01,
+	0x80,0xFE,0x00,0x01,0x07,0xC0,0xF8,0x00,0x00,0x01,0xE4,0x00
+};
+const LCDIMG_t LCDIMG_logo = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(logo_data),
+		.data = logo_data
+};
+
+// processing.pbm, 128x64, 366 bytes
+static const uint8_t processing_data[] = {
+	0x81,0x00,0xDA,0x00,0x00,0x20,0xFE,0x00,0x02,0x20,0x00,0x20,0xFE,0x00,0x01,0x1F,
+	0x80,0xFD,0x00,0x00,0x20,0xFE,0x00,0x02,0x20,0x00,0x50,0xFE,0x00,0x01,0x10,0x60,
+	0xFE,0x00,0x01,0x04,0x20,0xFE,0x00,0x02,0x20,0x10,0x88,0xFE,0x00,0x01,0x10,0x20,
+	0xFE,0x00,0x05,0x04,0x20,0x00,0x08,0x00,0x20,0xFC,0x00,0x0D,0x10,0x11,0xF1,0x78,
+	0xFC,0x0F,0xAF,0x10,0x48,0xE0,0x2F,0x10,0x78,0xBC,0xFF,0x00,0x0D,0x10,0x12,0x09,
+	0x8D,0x08,0x04,0x31,0x90,0x49,0x10,0x31,0x90,0x8C,0xC6,0xFF,0x00,0x0D,0x3E,0x10,
+	0x09,0x05,0x08,0x04,0x20,0x90,0x72,0x00,0x20,0x91,0x04,0x82,0xFF,0x00,0xFF,0x10,
+	0x0B,0xF9,0x05,0x08,0x04,0x20,0x90,0x42,0x00,0x20,0x91,0xFC,0x82,0xFF,0x00,0x0D,
+	0x10,0x13,0x09,0x05,0xF0,0x04,0x20,0x90,0x42,0x00,0x20,0x91,0x00,0x82,0xFF,0x00,
+	0x0D,0x10,0x22,0x09,0x05,0x00,0x04,0x20,0x90,0x42,0x00,0x20,0x91,0x00,0x82,0xFF,
+	0x00,0x0D,0x10,0x62,0x19,0x05,0xF8,0x04,0x20,0x98,0xC1,0x10,0x20,0x90,0x84,0x82,
+	0xFF,0x00,0x0D,0x1F,0x81,0xE9,0x04,0x84,0x03,0xA0,0x8F,0x41,0xE0,0x20,0x90,0x78,
+	0x82,0xFC,0x00,0x01,0x01,0x04,0xF3,0x00,0x01,0x01,0x0C,0xFF,0x00,0x00,0x02,0xFD,
+	0x00,0x00,0x10,0xFA,0x00,0x00,0xF8,0x81,0x00,0xFE,0x00,0x02,0x10,0x00,0x20,0xF4,
+	0x00,0x02,0x10,0x00,0x20,0xF8,0x00,0x00,0x20,0xFE,0x00,0x02,0x12,0x00,0x20,0xF4,
+	0x00,0x02,0x10,0x00,0x20,0xF9,0x00,0x07,0x3F,0x21,0xF0,0x78,0x01,0xD2,0x0E,0x2F,
+	0xF9,0x00,0x08,0x42,0x22,0x08,0x84,0x02,0x32,0x11,0x31,0x80,0xFA,0x00,0x05,0x42,
+	0x20,0x09,0x02,0x04,0x12,0xFF,0x20,0x00,0x80,0xFA,0x00,0x05,0x42,0x20,0xF9,0x02,
+	0x04,0x12,0xFF,0x20,0x00,0x80,0xFA,0x00,0x05,0x7C,0x23,0x09,0x02,0x04,0x12,0xFF,
+	0x20,0x00,0x80,0xFA,0x00,0x05,0x40,0x22,0x09,0x02,0x04,0x12,0xFF,0x20,0x00,0x80,
+	0xFA,0x00,0x08,0x7E,0x22,0x18,0x84,0x02,0x32,0x11,0x20,0x80,0xFA,0x00,0xFF,0x21,
+	0x06,0xE8,0x78,0x03,0xD2,0x1E,0x20,0x80,0xFA,0x00,0x00,0x41,0xF2,0x00,0x00,0x43,
+	0xF2,0x00,0x00,0x3E,0xFD,0x00,0x00,0x02,0x81,0x00,0x81,0x00,0xEB,0x00
+};
+const LCDIMG_t LCDIMG_processing = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(processing_data),
+		.data = processing_data
+};
+
+// welcome.pbm, 128x64, 718 bytes
+static const uint8_t welcome_data[] = {
+	0xF1,0xFF,0x00,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,
+	0x01,0x01,0x80,0xFE,0x00,0x01,0x40,0x10,0xFE,0x00,0x00,0x03,0xFC,0x00,0x01,0x01,
+	0x80,0xFF,0x00,0x02,0x1E,0x40,0x08,0xFE,0x00,0x00,0x01,0xFC,0x00,0x01,0x01,0x80,
+	0xFF,0x00,0x02,0x61,0x40,0x04,0xFD,0x00,0x00,0x80,0xFD,0x00,0x01,0x01,0x80,0xFF,
+	0x00,0xFF,0x40,0xFC,0x00,0x00,0x08,0xFD,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x80,
+	0x5C,0x1E,0x0E,0x01,0x73,0x84,0x29,0x70,0x7E,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,
+	0x09,0x80,0x62,0x21,0x11,0x01,0x8C,0x44,0x29,0x88,0x84,0xFF,0x00,0x01,0x01,0x80,
+	0xFF,0x00,0x09,0x80,0x41,0x01,0x20,0x81,0x08,0x44,0x31,0x04,0x84,0xFF,0x00,0x01,
+	0x01,0x80,0xFF,0x00,0x09,0x80,0x41,0x1F,0x20,0x81,0x08,0x44,0x21,0x04,0x84,0xFF,
+	0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x80,0x41,0x21,0x20,0x81,0x08,0x44,0x21,0x04,
+	0x78,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x40,0x41,0x21,0x20,0x81,0x08,0x44,
+	0x21,0x04,0x80,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x61,0x41,0x23,0x11,0x01,
+	0x08,0x44,0x61,0x04,0x7C,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x1E,0x41,0x1D,
+	0x0E,0x01,0x08,0x43,0xA1,0x04,0x82,0xFF,0x00,0x01,0x01,0x80,0xF6,0x00,0x00,0x82,
+	0xFF,0x00,0x01,0x01,0x80,0xF6,0x00,0x00,0x82,0xFF,0x00,0x01,0x01,0x80,0xF6,0x00,
+	0x00,0x7C,0xFF,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,
+	0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,
+	0xF3,0x00,0x01,0x01,0x80,0xFC,0x00,0xFE,0x80,0x03,0x04,0x00,0x80,0x20,0xFF,0x00,
+	0x01,0x01,0x80,0xFD,0x00,0x01,0x01,0x00,0xFF,0x80,0x03,0x08,0x00,0x80,0x20,0xFF,
+	0x00,0x01,0x01,0x80,0xFD,0x00,0x01,0x02,0x00,0xFF,0x80,0x03,0x10,0x00,0x80,0x20,
+	0xFF,0x00,0x01,0x01,0x80,0xFB,0x00,0xFF,0x80,0xFF,0x00,0x01,0x80,0x20,0xFF,0x00,
+	0x01,0x01,0x80,0xFF,0x00,0x09,0x0E,0x90,0x50,0x40,0x88,0xB8,0x3C,0x1C,0xB8,0x20,
+	0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x11,0x90,0x50,0x40,0x90,0xC4,0x42,0x22,
+	0xC4,0x20,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x20,0x90,0x48,0x80,0xA0,0x82,
+	0x02,0x40,0x82,0x20,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x20,0x90,0x48,0x80,
+	0xC0,0x82,0x3E,0x40,0x82,0x20,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x09,0x20,0x90,
+	0x45,0x00,0xA0,0x82,0x42,0x40,0x82,0x20,0xFF,0x00,0x01,0x01,0x80,0xFF,0x00,0x08,
+	0x20,0x90,0x45,0x00,0x90,0x82,0x42,0x40,0x82,0xFE,0x00,0x01,0x01,0x80,0xFF,0x00,
+	0x09,0x11,0x88,0xC2,0x00,0x88,0x82,0x46,0x22,0x82,0x20,0xFF,0x00,0x01,0x01,0x80,
+	0xFF,0x00,0x09,0x0E,0x87,0x42,0x00,0x84,0x82,0x3A,0x1C,0x82,0x20,0xFF,0x00,0x01,
+	0x01,0x80,0xFE,0x00,0x01,0x80,0x02,0xF8,0x00,0x01,0x01,0x80,0xFE,0x00,0x01,0x80,
+	0x04,0xF8,0x00,0x01,0x01,0x80,0xFE,0x00,0x01,0x80,0x04,0xF8,0x00,0x01,0x01,0x80,
+	0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,
+	0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,
+	0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,
+	0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x17,0x01,
+	0x80,0x04,0x24,0x17,0x98,0x9E,0x11,0x88,0x70,0x0E,0x1C,0x30,0x61,0x05,0x88,0x01,
+	0x80,0x04,0x24,0x14,0x18,0x91,0x11,0xFF,0x88,0x50,0x11,0x22,0x30,0x61,0x05,0x88,
+	0x01,0x80,0x0A,0x22,0x24,0x14,0x90,0x91,0x49,0x00,0x20,0x41,0x28,0xA0,0x89,0x48,
+	0x01,0x80,0x0A,0x22,0x27,0x94,0x90,0x91,0x49,0x00,0x20,0x41,0x28,0xA0,0x89,0x48,
+	0x01,0x80,0x11,0x21,0x44,0x12,0x90,0x91,0x29,0x38,0x20,0x41,0x25,0x20,0x51,0x28,
+	0x01,0x80,0x1F,0x21,0x44,0x12,0x90,0x91,0x29,0x08,0x20,0x41,0x25,0x20,0x51,0x28,
+	0x01,0x80,0x20,0xA0,0x84,0x11,0x91,0x11,0x18,0x88,0x11,0xFF,0x22,0x14,0x20,0x21,
+	0x18,0x01,0x80,0x20,0xA0,0x87,0x91,0x9E,0x11,0x18,0x71,0x0E,0x1C,0x22,0x24,0x21,
+	0x18,0x01,0x80,0xF3,0x00,0x01,0x01,0x80,0xF3,0x00,0x00,0x01,0xF1,0xFF
+};
+const LCDIMG_t LCDIMG_welcome = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(welcome_data),
+		.data = welcome_data
+};
+
+// working.pbm, 128x64, 143 bytes
+static const uint8_t working_data[] = {
+	0x81,0x00,0xF1,0x00,0xF1,0xFF,0x81,0x00,0x81,0x00,0x81,0x00,0x81,0x00,0x81,0x00,
+	0x05,0x00,0x06,0x40,0x00,0x60,0x0E,0xF7,0x00,0x05,0x7E,0x0F,0xC0,0x00,0x60,0x0E,
+	0xF7,0x00,0x05,0x7F,0x89,0x80,0x00,0x60,0x1F,0xF7,0x00,0x01,0x61,0x80,0xFF,0x00,
+	0x00,0x60,0xF6,0x00,0x06,0x60,0xC7,0x80,0xDC,0x6E,0x3F,0x37,0xF8,0x00,0x07,0xF8,
+	0xCF,0xC0,0xFE,0x7F,0x3F,0xBF,0x80,0xF9,0x00,0x07,0xF8,0xC8,0xC0,0xE6,0x73,0x01,
+	0xB9,0x80,0xF9,0x00,0x07,0x60,0xC7,0xC0,0xC6,0x63,0x1F,0xB1,0x80,0xF9,0x00,0x07,
+	0x60,0xCC,0xC0,0xC6,0x63,0x3F,0xB1,0x80,0xF9,0x00,0x07,0x61,0x8C,0xC0,0xC6,0x63,
+	0x31,0xB1,0x80,0xF9,0x00,0x07,0x7F,0x8F,0xC0,0xC6,0x63,0x3F,0xB1,0x80,0xF9,0x00,
+	0x07,0x7E,0x06,0xC0,0xC6,0x63,0x1F,0xB1,0x80,0xE4,0x00,0x00,0x0C,0xF7,0x00
+};
+const LCDIMG_t LCDIMG_working = {
+		.width = 128,
+		.height = 64,
+		.size = sizeof(working_data),
+		.data = working_data
+};
@@ -6,15 +6,18 @@
  */
 
 #include "main.h"
+#include "string.h"
 #include "DeviceManager/lcdmanager.h"
+#include "DeviceManager/lcdimages.h"
+#include "Device/lcd.h"
 #include "Device/rtc.h"
 #include "Lib/scheduler/scheduler.h"
 #include "Lib/utils/utils_logger.h"
 
 
-#define LCDMNG_WIDTH				128
-#define LCDMNG_HEIGHT				64
-#define SCREEN_SIZE					128 * 64 / 8
+#define LCDMNG_WIDTH				LCD_WIDTH
+#define LCDMNG_HEIGHT				LCD_HEIGHT
+#define SCREEN_SIZE					LCD_FRAME_SIZE
 #define INIT_SCREEN_DURATION		3000	// 3s
 #define WELCOME_SCREEN_DURATION		3000 	// 3s
 #define WORKING_SCREEN_DURATION		30000 	// 30s
@@ -40,31 +43,53 @@
 #define PASSWORD_SCREEN_X_POSITION					40
 #define PASSWORD_SCREEN_LINE_POSITION				0
 #define PASSWORD_DATA_SCREEN_X_POSITION				0
-#define PASSWORD_DATA_SCREEN_LINE_POSITION			3
+#define PASSWORD_DATA_SCREEN_LINE_POSITION			4	// On the text grid
 
 #define SETTING_SCREEN_FIELD_DATA_X_POSITION				6
 #define SETTING_SCREEN_FIELD_DATA_LINE_POSITION				6
-#define SETTING_SCREEN_DATA_X_POSITION						6
-#define SETTING_SCREEN_DATA_LINE_POSITION					3
+#define SETTING_SCREEN_DATA_X_POSITION						8	// On the text grid
+#define SETTING_SCREEN_DATA_LINE_POSITION					4
 
 #define BLINK_INTERVAL								1000
+#define BLINK_WIDTH									7
+#define BLINK_HEIGHT								16
+#define LCDMNG_OVERLAY_CURSOR						0
 
+#define LCDMNG_NUMBER_BUFFER_SIZE					16
+#define LCDMNG_TEXT_SIZE							26	// 24 chars of font5x7 per line
+#define LCDMNG_SETTING_DATA_LINE_MAX				3
 
+
+enum {
+	LCDMNG_WIDGET_TEXT,			// text is drawn as is
+	LCDMNG_WIDGET_NUMBER		// text is the printf format of value
+};
+
+// Where a widget is drawn, see LCDMNG_pick_layer
 enum {
-	LCDMNG_STATE_INIT,
-	LCDMNG_STATE_WAIT_FOR_INIT,
-	LCDMNG_STATE_WELCOME,
-	LCDMNG_STATE_WAIT_FOR_WELCOME,
-	LCDMNG_STATE_WORKING,
-	LCDMNG_STATE_PASSWORD,
-	LCDMNG_STATE_SETTING,
-	LCDMNG_STATE_SETTING_DATA,
-	LCDMNG_STATE_CARD_LOWER,
-	LCDMNG_STATE_CARD_EMPTY,
-	LCDMNG_STATE_CARD_ERROR,
-	LCDMNG_STATE_IDLE
+	LCDMNG_LAYER_GRAPHIC,		// Pixels of the widget font in the framebuffer, GDRAM
+	LCDMNG_LAYER_TEXT,			// ST7920 character ROM in DDRAM, 8x16 cells on the text grid
+	LCDMNG_LAYER_AUTO			// The layer costing less bus bytes for the current text
 };
 
+typedef struct {
+	uint8_t type;
+	uint8_t x;
+	uint8_t line;
+	const uint8_t *font;
+	const char *text;
+	uint32_t value;
+	bool visible;
+	uint8_t layer;
+	char *drawn;				// Text last composed, NULL disables LCDMNG_update_widget
+}LCDMNG_widget_t;
+
+typedef struct {
+	const LCDIMG_t *background;	// Compressed in flash, NULL is a blank screen
+	LCDMNG_widget_t *widgets;
+	size_t widget_count;
+}LCDMNG_screen_t;
+
 typedef struct {
 	char * name;
 	size_t x_position;
@@ -88,632 +113,64 @@ static void LCDMNG_run_blink();
 static void LCDMNG_blink();
 static void LCDMNG_set_blink(size_t x_position, size_t line_position);
 static void LCDMNG_clear_blink();
+static void LCDMNG_blink_after(const LCDMNG_widget_t *widget);
 static void LCDMNG_timeout();
+static void LCDMNG_start_timeout(uint32_t duration);
+static void LCDMNG_cancel_timeout();
+static void LCDMNG_account_bus();
 static void LCDMNG_timeout_for_blink();
 static void LCDMNG_printf();
-static void LCDMNG_draw_string(uint8_t *buff, uint8_t x, uint8_t line, uint8_t *c);
-static void LCDMNG_set_font(uint8_t *fontPtr);
-static void LCDMNG_draw_char(uint8_t *buff, uint8_t x, uint8_t line, uint8_t c);
-
-
-static uint8_t logo_screen[1024] = {  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
-		0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0xE0, 0xF8, 0xFC, 0xFE, 0xFE, 0xFF, 0xFF, 0x3F, 0x3F, 0x7F,
-		0x1E, 0x1E, 0x1C, 0x08, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xE0, 0xF0,
-		0xF8, 0xFC, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFC, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x20, 0x53, 0x23,
-		0xC7, 0x87, 0x0F, 0x0F, 0x04, 0x00, 0x80, 0x80, 0x40, 0x00, 0x10, 0x07,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xF0, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0x7F, 0x3F, 0x0F, 0x07, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x80, 0xF0, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x1F, 0x0F,
-		0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xC0, 0xF0, 0xF0, 0xFC, 0xFC, 0xFE,
-		0xFE, 0x7E, 0xFE, 0xFE, 0xFC, 0xF8, 0xF0, 0xC0, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xF0,
-		0xFE, 0xFF, 0xFF, 0xFF, 0x7F, 0x1F, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
-		0xC0, 0xF0, 0xF8, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x1F, 0x07, 0x03,
-		0x00, 0x00, 0x00, 0x07, 0x7F, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xF8, 0xFF, 0xFF, 0xFF,
-		0xFF, 0x1F, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xC0, 0xF0, 0xF8, 0xFE, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x1F, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0xC0, 0xF0, 0xFC, 0xFF, 0x7F, 0x1F, 0x0F, 0x07, 0x01,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F,
-		0x3F, 0x0F, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
-		0x30, 0x1C, 0x0F, 0x07, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x07, 0x0F, 0x1F,
-		0x1F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-
-static uint8_t welcome_screen[1024] = {  0xFF, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xC1, 0x41, 0x21, 0x21,
-		0x21, 0x21, 0x41, 0x01, 0xF1, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x11, 0x21, 0x41, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x11, 0x31, 0x41, 0x01, 0x01, 0x01, 0x81, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
-		0x01, 0x01, 0xFF,
-
-		0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x1F, 0x60, 0x40, 0x80, 0x80, 0x80, 0x80, 0x40, 0x00, 0xFF, 0x02, 0x01,
-		0x01, 0x01, 0x02, 0xFC, 0x00, 0x00, 0x72, 0x89, 0x89, 0x89, 0x49, 0xFE,
-		0x00, 0x00, 0x3C, 0x42, 0x81, 0x81, 0x81, 0x42, 0x3C, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0xFF, 0x02, 0x01, 0x01, 0x01, 0xFE, 0x02, 0x01, 0x01,
-		0x01, 0xFE, 0x00, 0x00, 0x00, 0x7F, 0x80, 0x80, 0x80, 0x40, 0xFF, 0x04,
-		0x03, 0x00, 0x00, 0xFF, 0x02, 0x01, 0x01, 0x01, 0x02, 0xFC, 0x00, 0x00,
-		0xAE, 0x51, 0x51, 0x51, 0x51, 0x4F, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
-
-		0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
-
-		0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x80, 0x40, 0x20, 0x20, 0x20, 0x40, 0xE0, 0x00, 0x00, 0xE0,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x60, 0x80, 0x00, 0x08, 0x04,
-		0x82, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x00, 0x80, 0x40,
-		0x20, 0x00, 0x00, 0x00, 0xFE, 0x40, 0x20, 0x20, 0x20, 0x40, 0x80, 0x00,
-		0x00, 0x40, 0x20, 0x28, 0x24, 0x22, 0xC0, 0x00, 0x00, 0x80, 0x40, 0x20,
-		0x20, 0x20, 0x40, 0x00, 0xFE, 0x40, 0x20, 0x20, 0x20, 0x40, 0x80, 0x00,
-		0x00, 0x00, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
-
-		0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x07, 0x08, 0x10, 0x10, 0x10, 0x08, 0xFF, 0x00, 0x00, 0x07,
-		0x08, 0x10, 0x10, 0x10, 0x08, 0x1F, 0x00, 0x00, 0x01, 0xC6, 0x38, 0x06,
-		0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x01, 0x02, 0x04,
-		0x08, 0x10, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00,
-		0x00, 0x0E, 0x11, 0x11, 0x11, 0x09, 0x1F, 0x00, 0x00, 0x07, 0x08, 0x10,
-		0x10, 0x10, 0x08, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00,
-		0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
-
-		0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
-
-		0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x80, 0x60, 0x80, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x60, 0x80, 0x00,
-		0x00, 0x00, 0x80, 0x60, 0x00, 0xE0, 0x20, 0x20, 0x20, 0x00, 0x00, 0xE0,
-		0x60, 0x80, 0x00, 0x00, 0xE0, 0x00, 0x00, 0xE0, 0x20, 0x20, 0x20, 0x40,
-		0x80, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xE0, 0x60, 0x80, 0x00, 0x00,
-		0xE0, 0x00, 0x00, 0x80, 0x40, 0x20, 0x20, 0x20, 0x40, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x80, 0x40, 0x20, 0x20, 0x20, 0x40, 0x00, 0x80, 0x40, 0x20,
-		0x20, 0x20, 0x40, 0x80, 0x00, 0x00, 0xE0, 0x60, 0x80, 0x00, 0x00, 0x00,
-		0x80, 0x60, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x60, 0x80, 0x00, 0x00, 0x00,
-		0x80, 0x60, 0x00, 0xE0, 0x60, 0x80, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
-
-		0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x98, 0x86,
-		0x85, 0x84, 0x85, 0x86, 0x98, 0x80, 0x9F, 0x80, 0x80, 0x80, 0x81, 0x86,
-		0x98, 0x86, 0x81, 0x80, 0x80, 0x9F, 0x91, 0x91, 0x91, 0x80, 0x80, 0x9F,
-		0x80, 0x81, 0x86, 0x98, 0x9F, 0x80, 0x80, 0x9F, 0x90, 0x90, 0x90, 0x88,
-		0x87, 0x80, 0x80, 0x9F, 0x80, 0x80, 0x80, 0x9F, 0x80, 0x81, 0x86, 0x98,
-		0x9F, 0x80, 0x80, 0x87, 0x88, 0x90, 0x92, 0x92, 0x8E, 0x80, 0x80, 0x90,
-		0x80, 0x80, 0x87, 0x88, 0x90, 0x90, 0x90, 0x88, 0x80, 0x87, 0x88, 0x90,
-		0x90, 0x90, 0x88, 0x87, 0x80, 0x80, 0x9F, 0x80, 0x81, 0x86, 0x98, 0x86,
-		0x81, 0x80, 0x9F, 0x80, 0x80, 0x90, 0x80, 0x80, 0x81, 0x86, 0x98, 0x86,
-		0x81, 0x80, 0x80, 0x9F, 0x80, 0x81, 0x86, 0x98, 0x9F, 0x80, 0x80, 0x80,
-		0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF };
-
-static const uint8_t working_screen[1024] = { 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00,
-
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x80, 0xF8, 0xF8, 0x98, 0x98, 0x18, 0x18, 0x30, 0xF0, 0xC0, 0x00, 0x00,
-		0x98, 0xCC, 0xCC, 0xD8, 0xD8, 0x8C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0xC0, 0xC0, 0x80, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0xFC, 0xFC, 0x80,
-		0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0xC0, 0xD0, 0xDC, 0xDC, 0xDC, 0xD0,
-		0x80, 0x00, 0xC0, 0xC0, 0x80, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-		0x01, 0x3F, 0x3F, 0x31, 0x31, 0x30, 0x30, 0x18, 0x1F, 0x07, 0x00, 0x00,
-		0x1D, 0x3E, 0x32, 0x12, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x3F, 0x3F, 0x01, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x3F, 0x3F, 0x01,
-		0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x1C, 0x3E, 0xB6, 0xB6, 0x36, 0x3F,
-		0x3F, 0x00, 0x3F, 0x3F, 0x01, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
-
-static uint8_t working_screen_temp[1024];
-
-
-
-static const uint8_t processing_screen[] = {
-		0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8,
-				0x08, 0x08, 0x08, 0x08, 0x08, 0x10, 0x30, 0xC0, 0x00, 0x00, 0x80, 0x40,
-				0x40, 0x40, 0x40, 0x40, 0x80, 0x00, 0x00, 0xC0, 0x80, 0x40, 0x40, 0x40,
-				0xC0, 0x80, 0x00, 0x80, 0x40, 0x40, 0x40, 0x40, 0xC0, 0x40, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x40, 0xF0, 0x40, 0x40, 0x40, 0x00, 0xFC, 0x80,
-				0x40, 0x40, 0x40, 0xC0, 0x80, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0xC0, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x80, 0x40, 0x40, 0x40, 0x80,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x80, 0x40, 0x40, 0x40, 0xC0,
-				0x80, 0x00, 0x00, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x90, 0x48, 0x44, 0x48,
-				0xD0, 0x80, 0x00, 0x00, 0xC0, 0x80, 0x40, 0x40, 0x40, 0xC0, 0x80, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3F,
-				0x21, 0x21, 0x21, 0x20, 0x20, 0x10, 0x18, 0x07, 0x00, 0x00, 0x1C, 0x24,
-				0x22, 0x22, 0x22, 0x12, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x3F, 0x00, 0xDF, 0x34, 0x14, 0x14, 0x14, 0x93, 0xE0, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x20, 0x20, 0x20, 0x00, 0x3F, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x1F, 0x30, 0x20, 0xA0, 0x20,
-				0x10, 0x3F, 0x01, 0x01, 0x00, 0x00, 0x0F, 0x30, 0x20, 0x20, 0x20, 0x10,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x0F, 0x12, 0x22, 0x22, 0xA2,
-				0x22, 0x13, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x10, 0x10,
-				0x10, 0x10, 0xF0, 0x10, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0x20, 0x10,
-				0x90, 0x90, 0x90, 0x90, 0xE0, 0x00, 0x00, 0xC0, 0x20, 0x10, 0x10, 0x10,
-				0x10, 0x20, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x10,
-				0x10, 0x10, 0x20, 0xFF, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0xC0, 0x20,
-				0x10, 0x10, 0x10, 0x20, 0x00, 0x00, 0xFF, 0x20, 0x10, 0x10, 0x10, 0x30,
-				0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x37, 0x4D, 0x45,
-				0x45, 0x45, 0x64, 0x38, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x07, 0x09,
-				0x08, 0x08, 0x08, 0x04, 0x0F, 0x00, 0x00, 0x03, 0x04, 0x08, 0x08, 0x08,
-				0x08, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x0C, 0x08,
-				0x08, 0x08, 0x04, 0x0F, 0x00, 0x00, 0x4F, 0x00, 0x00, 0x00, 0x03, 0x0C,
-				0x08, 0x08, 0x08, 0x04, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-static uint8_t password_screen[1024];
-static uint8_t setting_screen[1024];
-static uint8_t setting_data_screen[1024];
-static uint8_t card_lower_screen[1024] = {
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0xC0,0xC0,0x60,0x60,0x60,0x60,0x60,0x60,
-	0xE0,0xC0,0xC0,0x40,0x00,0x00,0x00,0x00,0x20,0x70,0xE0,0xC0,0x80,0x80,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x80,0xC0,0xE0,0x70,0x20,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xF8,
-	0xF8,0xF8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x1C,0x84,0x44,0x3C,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0xF8,0xFE,0xFF,0x03,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x01,0x00,0x00,0x80,0xE0,0xF0,0x30,0x18,0x18,0x18,0x19,0x18,0x38,0xF0,
-	0xE0,0x80,0x00,0x00,0x00,0xF8,0xF8,0xF8,0x30,0x10,0x18,0x18,0x18,0x18,0xF8,0xF0,
-	0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xF9,0xF8,0xF8,0x00,0x00,
-	0x18,0x18,0x18,0xFF,0xFF,0xFF,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x18,0x18,0x18,0xFF,0xFF,0xFF,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0xFF,
-	0xFF,0xFF,0x30,0x18,0x18,0x18,0x18,0xF8,0xF0,0xE0,0x00,0x00,0x00,0x00,0xC0,0xF0,
-	0xF8,0x98,0x8C,0x84,0x84,0x84,0x8C,0xF8,0xF8,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0x03,0x0F,0x3F,0x38,0x70,0x60,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,
-	0xE0,0x60,0x60,0x20,0x00,0x0F,0x3F,0x7F,0xE0,0xC0,0xC0,0xC0,0xC0,0xC0,0x60,0x7F,
-	0x3F,0x0F,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,
-	0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x00,0x00,
-	0x00,0x00,0x00,0x3F,0x7F,0xFF,0xC0,0xC0,0xC0,0x40,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x3F,0x7F,0xFF,0xC0,0xC0,0xC0,0x40,0x00,0x00,0x00,0xFF,
-	0xFF,0xFF,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x00,0x00,0x00,0x00,0x0F,0x3F,
-	0x7F,0xF0,0xE0,0xC0,0xC0,0xC0,0xC0,0x60,0x20,0x10,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-static uint8_t card_empty_screen[1024] = {
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x10,0xF0,
-		0xF0,0xF0,0x10,0x10,0x00,0x00,0x00,0x00,0x00,0x10,0x10,0xF0,0xF0,0xF0,0x10,0x10,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x80,0xC0,0x70,0x38,0x18,0x38,0xE0,0x80,0x38,0x1E,
-		0x06,0x02,0x00,0x00,0x00,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x08,0x08,0xF8,0xF8,0xF8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x04,0x84,0x6C,0x3C,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,
-		0xFF,0xFF,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xFF,0xFF,0xFF,0x00,0x00,
-		0x00,0x00,0x00,0x00,0xC0,0xF0,0xF8,0x18,0x0C,0x04,0x04,0x04,0x0C,0x39,0xF8,0xF0,
-		0x80,0x00,0x00,0x08,0x0C,0xFF,0xFF,0xFF,0x0C,0x0C,0x0C,0x0C,0x0C,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x08,0x0C,0xFF,0xFF,0xFF,0x0C,0x0C,0x0C,0x0C,0x0C,0x00,
-		0x00,0x00,0xFF,0xFF,0xFF,0x30,0x18,0x08,0x0C,0x0C,0x1C,0xFC,0xF8,0xF0,0x00,0x00,
-		0x00,0x00,0x00,0xC0,0xF0,0xF8,0x18,0x0C,0x04,0x05,0x04,0x0C,0x38,0xF8,0xF0,0x80,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,
-		0xFF,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x3F,0xFF,0xFF,0xC1,0x81,0x01,0x01,0x01,0x01,0x81,0x81,0x41,
-		0x01,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x80,0x00,0x00,0x00,0x80,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x80,0x00,0x00,0x00,0x80,0x00,
-		0x00,0x00,0xFF,0xFF,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0xFF,0x00,0x00,
-		0x00,0x00,0x00,0x3F,0xFF,0xFF,0xC1,0x81,0x01,0x01,0x01,0x01,0x81,0x81,0x41,0x01,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x02,0x03,
-		0x03,0x03,0x02,0x02,0x00,0x00,0x00,0x00,0x00,0x02,0x02,0x03,0x03,0x03,0x02,0x02,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x03,0x03,0x03,0x03,0x03,0x01,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x03,0x03,0x03,0x03,0x01,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x03,0x03,0x03,0x03,0x01,0x00,0x00,
-		0x02,0x02,0x03,0x03,0x03,0x02,0x02,0x00,0x00,0x00,0x02,0x03,0x03,0x03,0x02,0x02,
-		0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x03,0x03,0x03,0x03,0x03,0x01,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
+static void LCDMNG_show(uint8_t screen_id);
+static void LCDMNG_compose(uint8_t screen_id);
+static void LCDMNG_update_widget(uint8_t screen_id, uint8_t widget_id);
+static uint8_t LCDMNG_pick_layer(const LCDMNG_widget_t *widget, size_t len);
+static size_t LCDMNG_columns(const LCDMNG_widget_t *widget);
+static void LCDMNG_center_text(char *buf, size_t size, const LCDMNG_widget_t *widget, const char *text);
+static const char * LCDMNG_widget_text(const LCDMNG_widget_t *widget, char *number_buf);
+static char * LCDMNG_format_digits(char *buf, uint32_t value, uint8_t digits);
+static void LCDMNG_draw_image(uint8_t *buff, const LCDIMG_t *image);
+/**
+ * Stream a PackBits image to the top left of buff: header n < 128 copies
+ * the next n + 1 bytes, n > 128 repeats the next byte 257 - n times.
+ */
+static void LCDMNG_draw_image(uint8_t *buff, const LCDIMG_t *image){
+	const uint8_t *src = image->data;
+	const uint8_t *end = image->data + image->size;
+	uint8_t row_bytes = image->width / 8;
+	uint8_t x = 0;
+	uint8_t y = 0;
+	uint8_t n;
+	uint16_t count;
+	bool repeat;
+	while(src < end && y < image->height && y < LCDMNG_HEIGHT){
+		n = *src++;
+		if(n == 128){
+			continue;
+		}
+		repeat = n > 128;
+		count = repeat ? 257 - n : n + 1;
+		while(count-- && src < end){
+			if(x < LCD_ROW_BYTES){
+				buff[y * LCD_ROW_BYTES + x] = *src;
+			}
+			if(!repeat || count == 0){
+				src++;
+			}
+			if(++x >= row_bytes){
+				x = 0;
+				if(++y >= image->height || y >= LCDMNG_HEIGHT){
+					return;
+				}
+			}
+		}
+	}
+}
 
-static uint8_t card_error_screen[1024] = {
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xE0,
-		0xE0,0xE0,0xE0,0xE0,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xE0,0xE0,0xE0,
-		0xE0,0xE0,0xE0,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0xC0,0xE0,0xE0,
-		0x60,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x80,0xE0,0xE0,0xE0,0x60,0x00,0x00,0x00,0x00,0x00,0x08,0x8C,0xC6,0xE6,0x66,
-		0xEE,0xEC,0xCC,0x0C,0x06,0x02,0x00,0x00,0x00,0x00,0x00,0x80,0xE0,0xE0,0xE0,0x60,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xE0,0xFF,0xFF,
-		0xFF,0x3F,0x01,0xFF,0xFF,0xFE,0x00,0x00,0x00,0xC0,0xF0,0xFC,0x7F,0x1F,0xE7,0xFF,
-		0xFF,0xFF,0x0F,0x00,0x00,0x00,0xC0,0xE0,0xF0,0xF0,0x78,0x39,0x39,0x39,0x79,0xF8,
-		0xF0,0xF0,0xE0,0x00,0x00,0x00,0x78,0xF8,0xF8,0xF8,0x80,0x00,0x00,0x00,0x00,0xC0,
-		0xF0,0xF8,0xF8,0x78,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0xF8,0xFF,0xFF,0xFF,0x07,0x00,0x00,0x80,0xE0,0xE0,0xF0,0xF1,0x79,0x39,0x38,0x38,
-		0x38,0x79,0xF1,0xF1,0xE0,0x80,0x00,0x00,0x00,0x00,0xF8,0xF9,0xF9,0xF9,0x01,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xF8,0xFF,0xFF,0xFF,
-		0x07,0x00,0x00,0xFF,0xFF,0xFF,0xE0,0xF8,0xFF,0x3F,0x0F,0x01,0xE0,0xFE,0xFF,0xFF,
-		0x1F,0x00,0x00,0x00,0xF0,0xF8,0xFC,0xFC,0x1C,0x1C,0x1C,0x0E,0x8E,0xCE,0xFE,0xFF,
-		0xFF,0x3F,0x03,0x00,0x00,0x00,0x00,0x7F,0xFF,0xFF,0xFF,0x80,0xE0,0xF8,0xFF,0x3F,
-		0x0F,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xF0,0xFF,
-		0xFF,0xFF,0x1F,0x00,0x00,0x00,0x7E,0xFF,0xFF,0xFF,0xC3,0x80,0x00,0x00,0x00,0x80,
-		0xC0,0xF0,0xFF,0xFF,0x7F,0x1F,0x00,0x00,0xF0,0xFF,0xFF,0xFF,0x1F,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x07,0x07,0x07,0x07,0x00,
-		0x00,0x00,0x00,0x07,0x07,0x07,0x07,0x03,0x00,0x00,0x00,0x06,0x07,0x07,0x07,0x01,
-		0x00,0x00,0x00,0x00,0x01,0x03,0x07,0x07,0x07,0x07,0x07,0x03,0x03,0x07,0x07,0x07,
-		0x07,0x00,0x00,0xC0,0xC0,0xC0,0xE0,0xF0,0xFF,0xFF,0x7F,0x3F,0x0F,0x03,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x06,0x07,0x07,
-		0x07,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x03,0x03,0x07,0x07,0x07,0x07,0x07,0x07,
-		0x03,0x03,0x01,0x00,0x00,0x00,0x00,0x06,0x07,0x07,0x07,0x01,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
+static void LCDMNG_set_setting_data_line(uint8_t index, uint8_t x, uint8_t line, const char *text);
+static void LCDMNG_draw_string(uint8_t *buff, uint8_t x, uint8_t line, const char *c);
+static void LCDMNG_set_font(const uint8_t *fontPtr);
+static void LCDMNG_draw_char(uint8_t *buff, uint8_t x, uint8_t line, uint8_t c);
+static void LCDMNG_draw_row(uint8_t *buff, uint8_t x, uint8_t y, uint32_t bits, uint8_t width);
 
 
 static const uint8_t font5x7[] = {
@@ -723,116 +180,106 @@ static const uint8_t font5x7[] = {
 		0x20, // first char
 		0x60, // char count
 		// Fixed width; char width table not used !!!!
-
-		// font data
-		// font data
-		0x00, 0x00, 0x00, 0x00, 0x00,// (space)
-		0x00, 0x00, 0x5F, 0x00, 0x00,// !
-		0x00, 0x07, 0x00, 0x07, 0x00,// "
-		0x14, 0x7F, 0x14, 0x7F, 0x14,// #
-		0x24, 0x2A, 0x7F, 0x2A, 0x12,// $
-		0x23, 0x13, 0x08, 0x64, 0x62,// %
-		0x36, 0x49, 0x55, 0x22, 0x50,// &
-		0x00, 0x05, 0x03, 0x00, 0x00,// '
-		0x00, 0x1C, 0x22, 0x41, 0x00,// (
-		0x00, 0x41, 0x22, 0x1C, 0x00,// )
-		0x08, 0x2A, 0x1C, 0x2A, 0x08,// *
-		0x08, 0x08, 0x3E, 0x08, 0x08,// +
-		0x00, 0x50, 0x30, 0x00, 0x00,// ,
-		0x08, 0x08, 0x08, 0x08, 0x08,// -
-		0x00, 0x60, 0x60, 0x00, 0x00,// .
-		0x20, 0x10, 0x08, 0x04, 0x02,// /
-		0x3E, 0x51, 0x49, 0x45, 0x3E,// 0
-		0x00, 0x42, 0x7F, 0x40, 0x00,// 1
-		0x42, 0x61, 0x51, 0x49, 0x46,// 2
-		0x21, 0x41, 0x45, 0x4B, 0x31,// 3
-		0x18, 0x14, 0x12, 0x7F, 0x10,// 4
-		0x27, 0x45, 0x45, 0x45, 0x39,// 5
-		0x3C, 0x4A, 0x49, 0x49, 0x30,// 6
-		0x01, 0x71, 0x09, 0x05, 0x03,// 7
-		0x36, 0x49, 0x49, 0x49, 0x36,// 8
-		0x06, 0x49, 0x49, 0x29, 0x1E,// 9
-		0x00, 0x36, 0x36, 0x00, 0x00,// :
-		0x00, 0x56, 0x36, 0x00, 0x00,// ;
-		0x00, 0x08, 0x14, 0x22, 0x41,// <
-		0x14, 0x14, 0x14, 0x14, 0x14,// =
-		0x41, 0x22, 0x14, 0x08, 0x00,// >
-		0x02, 0x01, 0x51, 0x09, 0x06,// ?
-		0x32, 0x49, 0x79, 0x41, 0x3E,// @
-		0x7E, 0x11, 0x11, 0x11, 0x7E,// A
-		0x7F, 0x49, 0x49, 0x49, 0x36,// B
-		0x3E, 0x41, 0x41, 0x41, 0x22,// C
-		0x7F, 0x41, 0x41, 0x22, 0x1C,// D
-		0x7F, 0x49, 0x49, 0x49, 0x41,// E
-		0x7F, 0x09, 0x09, 0x01, 0x01,// F
-		0x3E, 0x41, 0x41, 0x51, 0x32,// G
-		0x7F, 0x08, 0x08, 0x08, 0x7F,// H
-		0x00, 0x41, 0x7F, 0x41, 0x00,// I
-		0x20, 0x40, 0x41, 0x3F, 0x01,// J
-		0x7F, 0x08, 0x14, 0x22, 0x41,// K
-		0x7F, 0x40, 0x40, 0x40, 0x40,// L
-		0x7F, 0x02, 0x04, 0x02, 0x7F,// M
-		0x7F, 0x04, 0x08, 0x10, 0x7F,// N
-		0x3E, 0x41, 0x41, 0x41, 0x3E,// O
-		0x7F, 0x09, 0x09, 0x09, 0x06,// P
-		0x3E, 0x41, 0x51, 0x21, 0x5E,// Q
-		0x7F, 0x09, 0x19, 0x29, 0x46,// R
-		0x46, 0x49, 0x49, 0x49, 0x31,// S
-		0x01, 0x01, 0x7F, 0x01, 0x01,// T
-		0x3F, 0x40, 0x40, 0x40, 0x3F,// U
-		0x1F, 0x20, 0x40, 0x20, 0x1F,// V
-		0x7F, 0x20, 0x18, 0x20, 0x7F,// W
-		0x63, 0x14, 0x08, 0x14, 0x63,// X
-		0x03, 0x04, 0x78, 0x04, 0x03,// Y
-		0x61, 0x51, 0x49, 0x45, 0x43,// Z
-		0x00, 0x00, 0x7F, 0x41, 0x41,// [
-		0x02, 0x04, 0x08, 0x10, 0x20,// "\"
-		0x41, 0x41, 0x7F, 0x00, 0x00,// ]
-		0x04, 0x02, 0x01, 0x02, 0x04,// ^
-		0x40, 0x40, 0x40, 0x40, 0x40,// _
-		0x00, 0x01, 0x02, 0x04, 0x00,// `
-		0x20, 0x54, 0x54, 0x54, 0x78,// a
-		0x7F, 0x48, 0x44, 0x44, 0x38,// b
-		0x38, 0x44, 0x44, 0x44, 0x20,// c
-		0x38, 0x44, 0x44, 0x48, 0x7F,// d
-		0x38, 0x54, 0x54, 0x54, 0x18,// e
-		0x08, 0x7E, 0x09, 0x01, 0x02,// f
-		0x08, 0x14, 0x54, 0x54, 0x3C,// g
-		0x7F, 0x08, 0x04, 0x04, 0x78,// h
-		0x00, 0x44, 0x7D, 0x40, 0x00,// i
-		0x20, 0x40, 0x44, 0x3D, 0x00,// j
-		0x00, 0x7F, 0x10, 0x28, 0x44,// k
-		0x00, 0x41, 0x7F, 0x40, 0x00,// l
-		0x7C, 0x04, 0x18, 0x04, 0x78,// m
-		0x7C, 0x08, 0x04, 0x04, 0x78,// n
-		0x38, 0x44, 0x44, 0x44, 0x38,// o
-		0x7C, 0x14, 0x14, 0x14, 0x08,// p
-		0x08, 0x14, 0x14, 0x18, 0x7C,// q
-		0x7C, 0x08, 0x04, 0x04, 0x08,// r
-		0x48, 0x54, 0x54, 0x54, 0x20,// s
-		0x04, 0x3F, 0x44, 0x40, 0x20,// t
-		0x3C, 0x40, 0x40, 0x20, 0x7C,// u
-		0x1C, 0x20, 0x40, 0x20, 0x1C,// v
-		0x3C, 0x40, 0x30, 0x40, 0x3C,// w
-		0x44, 0x28, 0x10, 0x28, 0x44,// x
-		0x0C, 0x50, 0x50, 0x50, 0x3C,// y
-		0x44, 0x64, 0x54, 0x4C, 0x44,// z
-		0x00, 0x08, 0x36, 0x41, 0x00,// {
-		0x00, 0x00, 0x7F, 0x00, 0x00,// |
-		0x00, 0x41, 0x36, 0x08, 0x00,// }
-		0x08, 0x08, 0x2A, 0x1C, 0x08,// ->
-		0x08, 0x1C, 0x2A, 0x08, 0x08 // <-
+		// font data, 8 rows of 1 byte(s) per char, MSB is the leftmost pixel
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,// (space)
+		0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x20, 0x00,// !
+		0x50, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00,// "
+		0x50, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0x50, 0x00,// #
+		0x20, 0x78, 0xA0, 0x70, 0x28, 0xF0, 0x20, 0x00,// $
+		0xC0, 0xC8, 0x10, 0x20, 0x40, 0x98, 0x18, 0x00,// %
+		0x60, 0x90, 0xA0, 0x40, 0xA8, 0x90, 0x68, 0x00,// &
+		0x60, 0x20, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,// '
+		0x10, 0x20, 0x40, 0x40, 0x40, 0x20, 0x10, 0x00,// (
+		0x40, 0x20, 0x10, 0x10, 0x10, 0x20, 0x40, 0x00,// )
+		0x00, 0x50, 0x20, 0xF8, 0x20, 0x50, 0x00, 0x00,// *
+		0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00,// +
+		0x00, 0x00, 0x00, 0x00, 0x60, 0x20, 0x40, 0x00,// ,
+		0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00,// -
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00,// .
+		0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00,// /
+		0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70, 0x00,// 0
+		0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00,// 1
+		0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xF8, 0x00,// 2
+		0xF8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70, 0x00,// 3
+		0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10, 0x00,// 4
+		0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, 0x00,// 5
+		0x30, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70, 0x00,// 6
+		0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, 0x00,// 7
+		0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00,// 8
+		0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60, 0x00,// 9
+		0x00, 0x60, 0x60, 0x00, 0x60, 0x60, 0x00, 0x00,// :
+		0x00, 0x60, 0x60, 0x00, 0x60, 0x20, 0x40, 0x00,// ;
+		0x08, 0x10, 0x20, 0x40, 0x20, 0x10, 0x08, 0x00,// <
+		0x00, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00,// =
+		0x80, 0x40, 0x20, 0x10, 0x20, 0x40, 0x80, 0x00,// >
+		0x70, 0x88, 0x08, 0x10, 0x20, 0x00, 0x20, 0x00,// ?
+		0x70, 0x88, 0x08, 0x68, 0xA8, 0xA8, 0x70, 0x00,// @
+		0x70, 0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x00,// A
+		0xF0, 0x88, 0x88, 0xF0, 0x88, 0x88, 0xF0, 0x00,// B
+		0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70, 0x00,// C
+		0xE0, 0x90, 0x88, 0x88, 0x88, 0x90, 0xE0, 0x00,// D
+		0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, 0x00,// E
+		0xF8, 0x80, 0x80, 0xE0, 0x80, 0x80, 0x80, 0x00,// F
+		0x70, 0x88, 0x80, 0x80, 0x98, 0x88, 0x70, 0x00,// G
+		0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, 0x00,// H
+		0x70, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00,// I
+		0x38, 0x10, 0x10, 0x10, 0x10, 0x90, 0x60, 0x00,// J
+		0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88, 0x00,// K
+		0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00,// L
+		0x88, 0xD8, 0xA8, 0x88, 0x88, 0x88, 0x88, 0x00,// M
+		0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88, 0x00,// N
+		0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00,// O
+		0xF0, 0x88, 0x88, 0xF0, 0x80, 0x80, 0x80, 0x00,// P
+		0x70, 0x88, 0x88, 0x88, 0xA8, 0x90, 0x68, 0x00,// Q
+		0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88, 0x00,// R
+		0x78, 0x80, 0x80, 0x70, 0x08, 0x08, 0xF0, 0x00,// S
+		0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00,// T
+		0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00,// U
+		0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00,// V
+		0x88, 0x88, 0x88, 0xA8, 0xA8, 0xD8, 0x88, 0x00,// W
+		0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00,// X
+		0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20, 0x00,// Y
+		0xF8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xF8, 0x00,// Z
+		0x38, 0x20, 0x20, 0x20, 0x20, 0x20, 0x38, 0x00,// [
+		0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x00,// "\"
+		0xE0, 0x20, 0x20, 0x20, 0x20, 0x20, 0xE0, 0x00,// ]
+		0x20, 0x50, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00,// ^
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00,// _
+		0x40, 0x20, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,// `
+		0x00, 0x00, 0x70, 0x08, 0x78, 0x88, 0x78, 0x00,// a
+		0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0xF0, 0x00,// b
+		0x00, 0x00, 0x70, 0x80, 0x80, 0x88, 0x70, 0x00,// c
+		0x08, 0x08, 0x68, 0x98, 0x88, 0x88, 0x78, 0x00,// d
+		0x00, 0x00, 0x70, 0x88, 0xF8, 0x80, 0x70, 0x00,// e
+		0x30, 0x48, 0x40, 0xE0, 0x40, 0x40, 0x40, 0x00,// f
+		0x00, 0x00, 0x78, 0x88, 0x78, 0x08, 0x30, 0x00,// g
+		0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0x88, 0x00,// h
+		0x20, 0x00, 0x60, 0x20, 0x20, 0x20, 0x70, 0x00,// i
+		0x10, 0x00, 0x30, 0x10, 0x10, 0x90, 0x60, 0x00,// j
+		0x40, 0x40, 0x48, 0x50, 0x60, 0x50, 0x48, 0x00,// k
+		0x60, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00,// l
+		0x00, 0x00, 0xD0, 0xA8, 0xA8, 0x88, 0x88, 0x00,// m
+		0x00, 0x00, 0xB0, 0xC8, 0x88, 0x88, 0x88, 0x00,// n
+		0x00, 0x00, 0x70, 0x88, 0x88, 0x88, 0x70, 0x00,// o
+		0x00, 0x00, 0xF0, 0x88, 0xF0, 0x80, 0x80, 0x00,// p
+		0x00, 0x00, 0x68, 0x98, 0x78, 0x08, 0x08, 0x00,// q
+		0x00, 0x00, 0xB0, 0xC8, 0x80, 0x80, 0x80, 0x00,// r
+		0x00, 0x00, 0x70, 0x80, 0x70, 0x08, 0xF0, 0x00,// s
+		0x40, 0x40, 0xE0, 0x40, 0x40, 0x48, 0x30, 0x00,// t
+		0x00, 0x00, 0x88, 0x88, 0x88, 0x98, 0x68, 0x00,// u
+		0x00, 0x00, 0x88, 0x88, 0x88, 0x50, 0x20, 0x00,// v
+		0x00, 0x00, 0x88, 0x88, 0xA8, 0xA8, 0x50, 0x00,// w
+		0x00, 0x00, 0x88, 0x50, 0x20, 0x50, 0x88, 0x00,// x
+		0x00, 0x00, 0x88, 0x88, 0x78, 0x08, 0x70, 0x00,// y
+		0x00, 0x00, 0xF8, 0x10, 0x20, 0x40, 0xF8, 0x00,// z
+		0x10, 0x20, 0x20, 0x40, 0x20, 0x20, 0x10, 0x00,// {
+		0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00,// |
+		0x40, 0x20, 0x20, 0x10, 0x20, 0x20, 0x40, 0x00,// }
+		0x00, 0x20, 0x10, 0xF8, 0x10, 0x20, 0x00, 0x00,// ->
+		0x00, 0x20, 0x40, 0xF8, 0x40, 0x20, 0x00, 0x00// <-
 };
 
 
-static const uint8_t black7x15 = {
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
-};
-static const uint8_t white7x15 = {
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
 static const uint8_t font7x15[] = {
 		0x0,
 		0x0,	// size of zero indicates fixed width font
@@ -840,70 +287,70 @@ static const uint8_t font7x15[] = {
 		15,		// height
 		'+',	// first char (48)
 		16,		// char count
+		// font data, 16 rows of 1 byte(s) per char, MSB is the leftmost pixel
 		// char '+'
-		0x00, 0x80, 0x80, 0xe0, 0xe0, 0x80, 0x80,
-		0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x7e,
+		0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char ','
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x58, 0x38, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x18, 0x18, 0x08, 0x10, 0x00,
 
 		// char '-'
-		0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '.'
-		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
 
 		// char '/'
-		0x00, 0x00, 0x00, 0xc0, 0xf0, 0x3c, 0x0f,
-		0x00, 0x3c, 0x0f, 0x03, 0x00, 0x00, 0x00,
+		0x02, 0x02, 0x06, 0x06, 0x0c, 0x0c, 0x18, 0x18,
+		0x30, 0x30, 0x60, 0x60, 0x40, 0x40, 0x00, 0x00,
 
 		// char '0'
-		0xfc, 0xfe, 0x03, 0xe1, 0x1b, 0xfe, 0xfc,
-		0x0f, 0x1f, 0x36, 0x21, 0x30, 0x1f, 0x0f,
+		0x38, 0x6c, 0xc6, 0xce, 0xce, 0xd6, 0xd6, 0xd6,
+		0xd6, 0xe6, 0xe6, 0xc6, 0x6c, 0x38, 0x00, 0x00,
 
 		// char '1'
-		0x04, 0x04, 0x06, 0xff, 0xff, 0x00, 0x00,
-		0x20, 0x20, 0x20, 0x3f, 0x3f, 0x20, 0x20,
+		0x18, 0x38, 0xf8, 0x18, 0x18, 0x18, 0x18, 0x18,
+		0x18, 0x18, 0x18, 0x18, 0x18, 0xfe, 0x00, 0x00,
 
 		// char '2'
-		0x0c, 0x0e, 0x03, 0x01, 0x81, 0xfe, 0x7c,
-		0x38, 0x3c, 0x26, 0x23, 0x21, 0x20, 0x20,
+		0x38, 0x64, 0xc6, 0xc6, 0x06, 0x06, 0x06, 0x0c,
+		0x18, 0x30, 0x60, 0xc0, 0xc0, 0xfe, 0x00, 0x00,
 
 		// char '3'
-		0x0c, 0x0e, 0x43, 0x41, 0x43, 0xfe, 0xbc,
-		0x0c, 0x1c, 0x30, 0x20, 0x30, 0x1f, 0x0f,
+		0x38, 0x6c, 0xc6, 0xc6, 0x06, 0x06, 0x3c, 0x06,
+		0x06, 0x06, 0xc6, 0xc6, 0x6c, 0x38, 0x00, 0x00,
 
 		// char '4'
-		0x00, 0xe0, 0xfc, 0x1f, 0x83, 0x80, 0x00,
-		0x0f, 0x0f, 0x08, 0x08, 0x3f, 0x3f, 0x08,
+		0x18, 0x18, 0x30, 0x30, 0x30, 0x60, 0x60, 0x6c,
+		0xcc, 0xcc, 0xcc, 0xfe, 0x0c, 0x0c, 0x00, 0x00,
 
 		// char '5'
-		0x3f, 0x3f, 0x21, 0x21, 0x61, 0xe1, 0x81,
-		0x0c, 0x1c, 0x30, 0x20, 0x30, 0x3f, 0x0f,
+		0xfe, 0xc0, 0xc0, 0xc0, 0xc0, 0xfc, 0x0c, 0x06,
+		0x06, 0x06, 0xc6, 0xc6, 0x6c, 0x3c, 0x00, 0x00,
 
 		// char '6'
-		0xe0, 0xf8, 0x5c, 0x46, 0xc3, 0xc1, 0x01,
-		0x0f, 0x1f, 0x30, 0x20, 0x30, 0x3f, 0x0f,
+		0x0e, 0x18, 0x30, 0x60, 0x60, 0xc0, 0xfc, 0xcc,
+		0xc6, 0xc6, 0xc6, 0xc6, 0x6c, 0x3c, 0x00, 0x00,
 
 		// char '7'
-		0x01, 0x01, 0x01, 0x81, 0xf1, 0x7f, 0x0f,
-		0x00, 0x00, 0x3c, 0x3f, 0x03, 0x00, 0x00,
+		0xfe, 0x06, 0x06, 0x06, 0x0c, 0x0c, 0x0c, 0x18,
+		0x18, 0x18, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00,
 
 		// char '8'
-		0x1c, 0xbe, 0xe3, 0x41, 0xe3, 0xbe, 0x1c,
-		0x0f, 0x1f, 0x30, 0x20, 0x30, 0x1f, 0x0f,
+		0x38, 0x6c, 0xc6, 0xc6, 0xc6, 0x6c, 0x38, 0x6c,
+		0xc6, 0xc6, 0xc6, 0xc6, 0x6c, 0x38, 0x00, 0x00,
 
 		// char '9'
-		0x3c, 0x7e, 0xc3, 0x81, 0x81, 0xfe, 0xfc,
-		0x20, 0x30, 0x38, 0x0c, 0x07, 0x03, 0x00,
+		0x38, 0x64, 0xc6, 0xc6, 0xc6, 0xc6, 0x66, 0x3e,
+		0x0c, 0x0c, 0x18, 0x30, 0x60, 0xe0, 0x00, 0x00,
 
 		// char ':'
-		0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00,
-		0x00, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00,
-
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00
 };
 
 static const uint8_t font15x31[] = {
@@ -913,127 +360,125 @@ static const uint8_t font15x31[] = {
 				31,		// height
 				'+',	// first char (48)
 				16,		// char count
+		// font data, 32 rows of 2 byte(s) per char, MSB is the leftmost pixel
 		// char '+'
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xfc, 0xfc, 0xfc,
-				0xfc, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0xff, 0xfe, 0xff, 0xfe,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char ','
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0xcf, 0xcf, 0x3f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x03, 0x00, 0x03, 0x00,
 
 		// char '-'
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,
-				0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xfe, 0xff, 0xfe,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '.'
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '/'
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0,
-				0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xff,
-				0xff, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xff, 0xff,
-				0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f,
-				0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x0e, 0x00, 0x0e, 0x00, 0x0e, 0x00, 0x0e, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c,
+		0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0,
+		0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00,
+		0x70, 0x00, 0x70, 0x00, 0x70, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '0'
-				0xf0, 0xf0, 0xfc, 0xfc, 0x0f, 0x0f, 0x03, 0x03, 0x03, 0xcf, 0xcf, 0xfc,
-				0xfc, 0xf0, 0xf0, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0xc0, 0xc0, 0x3c,
-				0x3f, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3c, 0x3c,
-				0x03, 0x03, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x03,
-				0x03, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x03, 0x03, 0x00, 0x00,
+		0x0f, 0xe0, 0x0f, 0xe0, 0x3c, 0x78, 0x3c, 0x78, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x7e, 0xf0, 0x7e,
+		0xf0, 0x7e, 0xf0, 0x7e, 0xf0, 0xde, 0xf0, 0xde, 0xf0, 0xde, 0xf0, 0xde, 0xf3, 0x1e, 0xf3, 0x1e,
+		0xf3, 0x1e, 0xf3, 0x1e, 0xfc, 0x1e, 0xfc, 0x1e, 0xfc, 0x1e, 0xfc, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0x3c, 0x78, 0x3c, 0x78, 0x0f, 0xe0, 0x0f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '1'
-				0x30, 0x30, 0x30, 0x30, 0x3c, 0x3c, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
-				0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x0c,
-				0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
+		0x03, 0xc0, 0x03, 0xc0, 0x0f, 0xc0, 0x0f, 0xc0, 0xff, 0xc0, 0xff, 0xc0, 0x03, 0xc0, 0x03, 0xc0,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0,
+		0x03, 0xc0, 0x03, 0xc0, 0xff, 0xfe, 0xff, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '2'
-				0xf0, 0xf0, 0xfc, 0xfc, 0x0f, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x0f, 0xff,
-				0xfc, 0xfc, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0,
-				0xc0, 0xf0, 0xff, 0x3f, 0x3f, 0x0f, 0xc0, 0xc0, 0xf0, 0xf0, 0x3c, 0x3c,
-				0x0f, 0x0f, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f,
-				0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
+		0x0f, 0xf0, 0x0f, 0xf0, 0x3c, 0x3c, 0x3c, 0x3c, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0xf0, 0x00, 0xf0,
+		0x03, 0xc0, 0x03, 0xc0, 0x0f, 0x00, 0x0f, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0xf0, 0x00, 0xf0, 0x00,
+		0xf0, 0x00, 0xf0, 0x00, 0xff, 0xfe, 0xff, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '3'
-				0xf0, 0xf0, 0xfc, 0xfc, 0x0f, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x0f, 0x1f,
-				0xfc, 0xfc, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30,
-				0x30, 0x30, 0x30, 0xff, 0xdf, 0x8f, 0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0x00, 0x00, 0x03,
-				0x03, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x03, 0x03, 0x00,
+		0x0f, 0xf0, 0x0f, 0xf0, 0x3c, 0x3c, 0x3c, 0x3c, 0xf0, 0x1e, 0xf0, 0x0e, 0xf0, 0x0e, 0xf0, 0x0e,
+		0x00, 0x0e, 0x00, 0x0e, 0x00, 0x0e, 0x00, 0x0e, 0x0f, 0xfc, 0x0f, 0xf8, 0x00, 0x0c, 0x00, 0x0e,
+		0x00, 0x0e, 0x00, 0x0e, 0x00, 0x0e, 0x00, 0x0e, 0xf0, 0x0e, 0xf0, 0x0e, 0xf0, 0x0e, 0xf0, 0x1e,
+		0x3c, 0x3c, 0x3c, 0x3c, 0x0f, 0xf0, 0x0f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '4'
-				0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xff, 0xff, 0x0f, 0x0f, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xfc, 0xff, 0xff, 0x03, 0x03, 0xc0,
-				0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xc0, 0xc0,
-				0xc0, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00,
+		0x0f, 0x00, 0x0f, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0xf0, 0x3c, 0xf0,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xff, 0xfe, 0xff, 0xfe,
+		0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '5'
-				0xff, 0xff, 0xff, 0xff, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
-				0x03, 0x03, 0x03, 0x0f, 0x0f, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
-				0x0c, 0x3c, 0xfc, 0xf0, 0xf0, 0xc0, 0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x03,
-				0x03, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x03, 0x03, 0x00,
+		0xff, 0xfe, 0xff, 0xfe, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0xf0, 0x00,
+		0xf0, 0x00, 0xf0, 0x00, 0xff, 0xf0, 0xff, 0xf0, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x1e, 0x00, 0x1e,
+		0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0x3c, 0x3c, 0x3c, 0x3c, 0x0f, 0xf0, 0x0f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '6'
-				0x00, 0x00, 0xc0, 0xc0, 0xf0, 0xf0, 0x3c, 0x3c, 0x0f, 0x0f, 0x03, 0x03,
-				0x03, 0x03, 0x03, 0xfc, 0xfc, 0xff, 0xff, 0x33, 0x33, 0x30, 0x30, 0x30,
-				0x30, 0xf0, 0xf0, 0xc0, 0xc0, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x03,
-				0x03, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x03, 0x03, 0x00,
+		0x00, 0xfe, 0x00, 0xfe, 0x03, 0xc0, 0x03, 0xc0, 0x0f, 0x00, 0x0f, 0x00, 0x3c, 0x00, 0x3c, 0x00,
+		0x3c, 0x00, 0x3c, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0xff, 0xf0, 0xff, 0xf0, 0xf0, 0x3c, 0xf0, 0x3c,
+		0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0x3c, 0x3c, 0x3c, 0x3c, 0x0f, 0xf0, 0x0f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '7'
-				0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xff,
-				0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xc0,
-				0xff, 0xff, 0x3f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0,
-				0xf0, 0xff, 0xff, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xff, 0xfe, 0xff, 0xfe, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e, 0x00, 0x1e,
+		0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x00, 0x78, 0x01, 0xe0, 0x01, 0xe0,
+		0x01, 0xe0, 0x01, 0xe0, 0x01, 0xe0, 0x01, 0xe0, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80,
+		0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '8'
-				0xf0, 0xf0, 0xfc, 0xfc, 0x0f, 0x0f, 0x03, 0x03, 0x03, 0x0f, 0x0f, 0xfc,
-				0xfc, 0xf0, 0xf0, 0x03, 0x03, 0xcf, 0xcf, 0xfc, 0xfc, 0x30, 0x30, 0x30,
-				0xfc, 0xfc, 0xcf, 0xcf, 0x03, 0x03, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x03,
-				0x03, 0x0f, 0x0f, 0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x03, 0x03, 0x00, 0x00,
+		0x0f, 0xe0, 0x0f, 0xe0, 0x3c, 0x78, 0x3c, 0x78, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0xf0, 0x1e, 0xf0, 0x1e, 0x3c, 0x78, 0x3c, 0x78, 0x0f, 0xe0, 0x0f, 0xe0, 0x3c, 0x78, 0x3c, 0x78,
+		0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0x3c, 0x78, 0x3c, 0x78, 0x0f, 0xe0, 0x0f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char '9'
-				0xe0, 0xf0, 0xfc, 0xfc, 0x0f, 0x0f, 0x03, 0x03, 0x03, 0x0f, 0x0f, 0xfc,
-				0xfc, 0xf0, 0xe0, 0x07, 0x0f, 0x3f, 0x3f, 0xf0, 0xf0, 0xc0, 0xc0, 0xc0,
-				0xc0, 0xc0, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0xc0, 0xc0, 0xfc, 0xfc, 0x3f, 0x3f, 0x03, 0x0c, 0x0c, 0x0c,
-				0x0c, 0x0c, 0x0c, 0x0f, 0x0f, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x0f, 0xe0, 0x0f, 0xe0, 0x3c, 0x78, 0x3c, 0x78, 0x70, 0x1c, 0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e,
+		0xf0, 0x1e, 0xf0, 0x1e, 0xf0, 0x1e, 0x70, 0x1e, 0x3c, 0x1e, 0x3c, 0x1e, 0x0f, 0xfe, 0x0f, 0xfe,
+		0x00, 0x0e, 0x00, 0x0e, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0xf0, 0x00, 0xf0,
+		0x03, 0xc0, 0x03, 0xc0, 0xff, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 
 		// char ':'
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x3c, 0x3c,
-				0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-				0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
-
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
 
-static uint8_t* font;
-static uint8_t* curr_screen;
+static const uint8_t* font;
+static uint8_t framebuffer[SCREEN_SIZE];
+static char text_frame[LCD_TEXT_SIZE];
+static const char* lcdmng_screen_name[LCDMNG_SCREEN_MAX] = {
+		[LCDMNG_SCREEN_NONE] = "none",
+		[LCDMNG_SCREEN_LOGO] = "logo",
+		[LCDMNG_SCREEN_WELCOME] = "welcome",
+		[LCDMNG_SCREEN_WORKING] = "working",
+		[LCDMNG_SCREEN_PASSWORD] = "password",
+		[LCDMNG_SCREEN_SETTING] = "setting",
+		[LCDMNG_SCREEN_SETTING_DATA] = "setting_data",
+		[LCDMNG_SCREEN_CARD_LOWER] = "card_lower",
+		[LCDMNG_SCREEN_CARD_EMPTY] = "card_empty",
+		[LCDMNG_SCREEN_CARD_ERROR] = "card_error"
+};
+static uint8_t curr_screen = LCDMNG_SCREEN_NONE;
 
 static uint8_t prev_state = LCDMNG_STATE_INIT;
 static uint8_t state = LCDMNG_STATE_INIT;
-static const char* lcdmng_state_name[] = {
+static const char* lcdmng_state_name[LCDMNG_STATE_MAX] = {
 		[LCDMNG_STATE_INIT] = "LCDMNG_STATE_INIT\r\n",
 		[LCDMNG_STATE_WAIT_FOR_INIT] = "LCDMNG_STATE_WAIT_FOR_INIT\r\n",
 		[LCDMNG_STATE_WELCOME] = "LCDMNG_STATE_WELCOME\r\n",
@@ -1090,14 +535,148 @@ static const char * SAVED		= 	"       Da luu     ";
 static const char * DELETED_CHECK = "  Ban co muon xoa ?";
 static const char * DELETED		= 	"       Da xoa     ";
 
+// Widgets
+enum {
+	LCDMNG_WORKING_WIDGET_TIME,
+	LCDMNG_WORKING_WIDGET_DATE,
+	LCDMNG_WORKING_WIDGET_AMOUNT,
+	LCDMNG_WORKING_WIDGET_MAX
+};
+
+enum {
+	LCDMNG_PASSWORD_WIDGET_TITLE,
+	LCDMNG_PASSWORD_WIDGET_DATA,
+	LCDMNG_PASSWORD_WIDGET_MAX
+};
+
+enum {
+	LCDMNG_SETTING_DATA_WIDGET_TITLE,
+	LCDMNG_SETTING_DATA_WIDGET_LINE,
+	LCDMNG_SETTING_DATA_WIDGET_MAX = LCDMNG_SETTING_DATA_WIDGET_LINE + LCDMNG_SETTING_DATA_LINE_MAX
+};
+
+static char working_drawn[LCDMNG_WORKING_WIDGET_MAX][LCDMNG_NUMBER_BUFFER_SIZE];
+static char time_text[6];
+static char date_text[11];
+static char password_text[LCDMNG_TEXT_SIZE];
+static char setting_text[LCDMNG_SETTING_FIELD_DELETE_TOTAL_AMOUNT][LCDMNG_TEXT_SIZE];
+static char setting_data_title_text[LCDMNG_TEXT_SIZE];
+static char setting_data_text[LCDMNG_SETTING_DATA_LINE_MAX][LCDMNG_TEXT_SIZE];
+
+static LCDMNG_widget_t working_widgets[LCDMNG_WORKING_WIDGET_MAX] = {
+		[LCDMNG_WORKING_WIDGET_TIME] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.x = WORKING_SCREEN_TIME_X_POSITION,
+			.line = WORKING_SCREEN_TIME_LINE_POSITION,
+			.font = font15x31,
+			.text = time_text,
+			.visible = true,
+			.drawn = working_drawn[LCDMNG_WORKING_WIDGET_TIME]
+		},
+		[LCDMNG_WORKING_WIDGET_DATE] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.x = WORKING_SCREEN_DATE_X_POSITION,
+			.line = WORKING_SCREEN_DATE_LINE_POSITION,
+			.font = font5x7,
+			.text = date_text,
+			.visible = true,
+			.drawn = working_drawn[LCDMNG_WORKING_WIDGET_DATE]
+		},
+		[LCDMNG_WORKING_WIDGET_AMOUNT] = {
+			.type = LCDMNG_WIDGET_NUMBER,
+			.x = WORKING_SCREEN_AMOUNT_X_POSITION,
+			.line = WORKING_SCREEN_AMOUNT_LINE_POSITION,
+			.font = font7x15,
+			.text = "%d.000",
+			.visible = true,
+			.drawn = working_drawn[LCDMNG_WORKING_WIDGET_AMOUNT]
+		}
+};
+
+static LCDMNG_widget_t password_widgets[LCDMNG_PASSWORD_WIDGET_MAX] = {
+		[LCDMNG_PASSWORD_WIDGET_TITLE] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.x = PASSWORD_SCREEN_X_POSITION,
+			.line = PASSWORD_SCREEN_LINE_POSITION,
+			.font = font5x7,
+			.text = "Password",
+			.visible = true
+		},
+		[LCDMNG_PASSWORD_WIDGET_DATA] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.x = PASSWORD_DATA_SCREEN_X_POSITION,
+			.line = PASSWORD_DATA_SCREEN_LINE_POSITION,
+			.font = font5x7,
+			.text = password_text,
+			.visible = false,
+			.layer = LCDMNG_LAYER_AUTO
+		}
+};
+
+// Filled from setting_field_info by LCDMNG_init
+static LCDMNG_widget_t setting_widgets[LCDMNG_SETTING_FIELD_DELETE_TOTAL_AMOUNT];
+
+static LCDMNG_widget_t setting_data_widgets[LCDMNG_SETTING_DATA_WIDGET_MAX] = {
+		[LCDMNG_SETTING_DATA_WIDGET_TITLE] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.font = font5x7,
+			.text = setting_data_title_text,
+			.visible = true
+		},
+		[LCDMNG_SETTING_DATA_WIDGET_LINE] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.font = font5x7,
+			.text = setting_data_text[0],
+			.layer = LCDMNG_LAYER_AUTO
+		},
+		[LCDMNG_SETTING_DATA_WIDGET_LINE + 1] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.font = font5x7,
+			.text = setting_data_text[1],
+			.layer = LCDMNG_LAYER_AUTO
+		},
+		[LCDMNG_SETTING_DATA_WIDGET_LINE + 2] = {
+			.type = LCDMNG_WIDGET_TEXT,
+			.font = font5x7,
+			.text = setting_data_text[2],
+			.layer = LCDMNG_LAYER_AUTO
+		}
+};
+
+static const LCDMNG_screen_t screens[LCDMNG_SCREEN_MAX] = {
+		[LCDMNG_SCREEN_LOGO] = { .background = &LCDIMG_logo },
+		[LCDMNG_SCREEN_WELCOME] = { .background = &LCDIMG_welcome },
+		[LCDMNG_SCREEN_WORKING] = {
+			.background = &LCDIMG_working,
+			.widgets = working_widgets,
+			.widget_count = LCDMNG_WORKING_WIDGET_MAX
+		},
+		[LCDMNG_SCREEN_PASSWORD] = {
+			.widgets = password_widgets,
+			.widget_count = LCDMNG_PASSWORD_WIDGET_MAX
+		},
+		[LCDMNG_SCREEN_SETTING] = {
+			.widgets = setting_widgets,
+			.widget_count = LCDMNG_SETTING_FIELD_DELETE_TOTAL_AMOUNT
+		},
+		[LCDMNG_SCREEN_SETTING_DATA] = {
+			.widgets = setting_data_widgets,
+			.widget_count = LCDMNG_SETTING_DATA_WIDGET_MAX
+		},
+		[LCDMNG_SCREEN_CARD_LOWER] = { .background = &LCDIMG_card_lower },
+		[LCDMNG_SCREEN_CARD_EMPTY] = { .background = &LCDIMG_card_empty },
+		[LCDMNG_SCREEN_CARD_ERROR] = { .background = &LCDIMG_card_error },
+};
+
 static uint32_t timeout_task_id;
+static bool timeout_pending = false;
 
 // For blink
 static bool timeout = false;
 static bool timeout_for_blink = false;
-static size_t blink_x_position;
-static size_t blink_line_position;
+static uint32_t blink_task_id;
 static bool blink_enable = false;
+static bool blink_on = false;
 
 // For screen
 static bool password_enable = false;
@@ -1108,6 +687,12 @@ static bool card_empty_enable = false;
 static bool card_error_enable = false;
 static bool idle_enable = true;
 
+// Metrics
+static LCDMNG_metrics_t metrics;
+static uint8_t timeout_state;			// State which armed the pending timeout
+static uint32_t metrics_bus_bytes;		// LCD stats at the last accounting
+static uint32_t metrics_bus_us;
+
 static void LCDMNG_setting_data_time(void * data, size_t data_len, uint8_t state);
 static void LCDMNG_setting_data_card_price(void * data, size_t data_len, uint8_t state);
 static void LCDMNG_setting_data_password(void * data, size_t data_len, uint8_t state);
@@ -1117,10 +702,18 @@ static void LCDMNG_setting_data_total_amount(void * data, size_t data_len, uint8
 static void LCDMNG_setting_data_delete_total_amount(void * data, size_t data_len, uint8_t state);
 
 void LCDMNG_init(){
-	// Do nothing
-	memset(setting_screen, 0 ,sizeof(setting_screen));
-	memset(setting_data_screen, 0 , sizeof(setting_data_screen));
-	memcpy(working_screen_temp, working_screen, sizeof(working_screen));
+	LCDMNG_widget_t *widget;
+	for (int field_id = LCDMNG_SETTING_FIELD_DATE_TIME; field_id <= LCDMNG_SETTING_FIELD_DELETE_TOTAL_AMOUNT; ++field_id) {
+		widget = &setting_widgets[field_id - LCDMNG_SETTING_FIELD_DATE_TIME];
+		snprintf(setting_text[field_id - LCDMNG_SETTING_FIELD_DATE_TIME], LCDMNG_TEXT_SIZE, "%d %s", field_id, setting_field_info[field_id].name);
+		widget->type = LCDMNG_WIDGET_TEXT;
+		widget->x = setting_field_info[field_id].x_position;
+		widget->line = setting_field_info[field_id].line_position;
+		widget->font = font5x7;
+		widget->text = setting_text[field_id - LCDMNG_SETTING_FIELD_DATE_TIME];
+		widget->visible = true;
+		widget->layer = LCDMNG_LAYER_GRAPHIC;	// 7 lines of menu do not fit the 4 text rows
+	}
 }
 
 void LCDMNG_run(){
@@ -1166,12 +759,15 @@ void LCDMNG_run(){
 			break;
 	}
 	LCDMNG_printf();
+	if(prev_state != state){
+		metrics.states[state].entries++;
+	}
 	prev_state = state;
 }
 
 static void LCDMNG_state_init(){
-	LCD_draw_bitmap(logo_screen);
-	timeout_task_id = SCH_Add_Task(LCDMNG_timeout, INIT_SCREEN_DURATION, 0);
+	LCDMNG_show(LCDMNG_SCREEN_LOGO);
+	LCDMNG_start_timeout(INIT_SCREEN_DURATION);
 	state = LCDMNG_STATE_WAIT_FOR_INIT;
 }
 
@@ -1182,17 +778,17 @@ static void LCDMNG_state_wait_for_init(){
 }
 
 static void LCDMNG_state_welcome(){
-	LCD_draw_bitmap(welcome_screen);
+	LCDMNG_show(LCDMNG_SCREEN_WELCOME);
 	timeout = false;
-	timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WELCOME_SCREEN_DURATION, 0);
+	LCDMNG_start_timeout(WELCOME_SCREEN_DURATION);
 	state = LCDMNG_STATE_WAIT_FOR_WELCOME;
 }
 
 static void LCDMNG_state_wait_for_welcome(){
 	if(timeout){
 		timeout = false;
-		LCD_draw_bitmap(working_screen_temp);
-		timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION, 0);
+		LCDMNG_show(LCDMNG_SCREEN_WORKING);
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION);
 		state = LCDMNG_STATE_WORKING;
 	}
 }
@@ -1200,36 +796,32 @@ static void LCDMNG_state_wait_for_welcome(){
 static void LCDMNG_state_working(){
 	// Switch immediately
 	if(password_enable){
-		curr_screen = password_screen;
 		// Donot create timeout -> Only switch again when press exit
-		LCD_draw_bitmap(password_screen);
+		LCDMNG_show(LCDMNG_SCREEN_PASSWORD);
 		state = LCDMNG_STATE_PASSWORD;
 	}
 	else if(timeout){
 		if(card_error_enable){
 			timeout = false;
-			curr_screen = card_error_screen;
-			LCD_draw_bitmap(card_error_screen);
-			timeout_task_id = SCH_Add_Task(LCDMNG_timeout, CARD_ERROR_SCREEN_DURATION, 0);
+			LCDMNG_show(LCDMNG_SCREEN_CARD_ERROR);
+			LCDMNG_start_timeout(CARD_ERROR_SCREEN_DURATION);
 			state = LCDMNG_STATE_CARD_ERROR;
 		}
 		else if(card_empty_enable){
 			timeout = false;
-			curr_screen = card_empty_screen;
-			LCD_draw_bitmap(card_empty_screen);
-			timeout_task_id = SCH_Add_Task(LCDMNG_timeout, CARD_EMPTY_SCREEN_DURATION, 0);
+			LCDMNG_show(LCDMNG_SCREEN_CARD_EMPTY);
+			LCDMNG_start_timeout(CARD_EMPTY_SCREEN_DURATION);
 			state = LCDMNG_STATE_CARD_EMPTY;
 		}
 		else if(card_lower_enable){
 			timeout = false;
-			curr_screen = card_lower_screen;
-			LCD_draw_bitmap(card_lower_screen);
-			timeout_task_id = SCH_Add_Task(LCDMNG_timeout, CARD_LOWER_SCREEN_DURATION, 0);
+			LCDMNG_show(LCDMNG_SCREEN_CARD_LOWER);
+			LCDMNG_start_timeout(CARD_LOWER_SCREEN_DURATION);
 			state = LCDMNG_STATE_CARD_LOWER;
 		}else if(idle_enable){
 			timeout = false;
-			LCD_draw_bitmap(logo_screen);
-			timeout_task_id = SCH_Add_Task(LCDMNG_timeout, IDLE_SCREEN_DURATION, 0);
+			LCDMNG_show(LCDMNG_SCREEN_LOGO);
+			LCDMNG_start_timeout(IDLE_SCREEN_DURATION);
 			state = LCDMNG_STATE_IDLE;
 		}
 	}
@@ -1237,39 +829,35 @@ static void LCDMNG_state_working(){
 
 static void LCDMNG_state_password(){
 	if(setting_enable){
-		curr_screen = setting_screen;
 		// Donot create timeout -> Only switch again when press exit
-		LCD_draw_bitmap(setting_screen);
+		LCDMNG_show(LCDMNG_SCREEN_SETTING);
 		state = LCDMNG_STATE_SETTING;
 	}
 	else if(!password_enable){
-		curr_screen = working_screen_temp;
 		// Switch to Working screen
 		timeout = false;
-		LCD_draw_bitmap(working_screen_temp);
-		SCH_Delete_Task(timeout_task_id);
-		timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION, 0);
+		LCDMNG_show(LCDMNG_SCREEN_WORKING);
+		LCDMNG_cancel_timeout();
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION);
 		state = LCDMNG_STATE_WORKING;
 	}
 }
 
 static void LCDMNG_state_setting(){
 	if(setting_data_enable){
-		curr_screen = setting_data_screen;
 		// Switch to Working screen
-		LCD_draw_bitmap(setting_data_screen);
+		LCDMNG_show(LCDMNG_SCREEN_SETTING_DATA);
 		state = LCDMNG_STATE_SETTING_DATA;
 	}
 	// Only get out of this screen when setting is false <=> press exit
 	else if(!setting_enable){
-		curr_screen = working_screen_temp;
 		// Disable password screen too
 		password_enable = false;
 		// Switch to Working screen
 		timeout = false;
-		LCD_draw_bitmap(working_screen_temp);
-		SCH_Delete_Task(timeout_task_id);
-		timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION, 0);
+		LCDMNG_show(LCDMNG_SCREEN_WORKING);
+		LCDMNG_cancel_timeout();
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION);
 		state = LCDMNG_STATE_WORKING;
 	}
 
@@ -1278,21 +866,19 @@ static void LCDMNG_state_setting(){
 static void LCDMNG_state_setting_data(){
 	// Switch back to setting screen when setting_data is false <=> press exti
 	if(!setting_data_enable){
-		curr_screen = setting_screen;
 		// Switch to Working screen
-		LCD_draw_bitmap(setting_screen);
+		LCDMNG_show(LCDMNG_SCREEN_SETTING);
 		state = LCDMNG_STATE_SETTING;
 	}
 }
 
 static void LCDMNG_state_card_lower(){
 	if(timeout){
-		curr_screen = working_screen_temp;
 		timeout = false;
 		// Draw lower screen -> Switch again to Working
-		LCD_draw_bitmap(working_screen_temp);
+		LCDMNG_show(LCDMNG_SCREEN_WORKING);
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION_WHEN_LOWER_CARD);
 		state = LCDMNG_STATE_WORKING;
-		SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION_WHEN_LOWER_CARD, 0);
 	}
 }
 
@@ -1300,8 +886,8 @@ static void LCDMNG_state_card_empty(){
 	// If timeout
 	if(timeout){
 		timeout = false;
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION_WHEN_EMPTY_CARD);
 		state = LCDMNG_STATE_WORKING;
-		timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION_WHEN_EMPTY_CARD, 0);
 	}
 }
 
@@ -1309,19 +895,18 @@ static void LCDMNG_state_card_error(){
 	// If timeout
 	if(timeout){
 		timeout = false;
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION_WHEN_ERROR_CARD);
 		state = LCDMNG_STATE_WORKING;
-		timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION_WHEN_ERROR_CARD, 0);
 	}
 }
 
 static void LCDMNG_state_idle(){
 	// Do nothing
 	if(timeout){
-		curr_screen = working_screen_temp;
 		timeout = false;
-		LCD_draw_bitmap(working_screen_temp);
+		LCDMNG_show(LCDMNG_SCREEN_WORKING);
+		LCDMNG_start_timeout(WORKING_SCREEN_DURATION);
 		state = LCDMNG_STATE_WORKING;
-		timeout_task_id = SCH_Add_Task(LCDMNG_timeout, WORKING_SCREEN_DURATION, 0);
 	}
 }
 
@@ -1330,40 +915,57 @@ static void LCDMNG_run_blink(){
 		if(timeout_for_blink){
 			LCDMNG_blink();
 			timeout_for_blink = false;
-			SCH_Add_Task(LCDMNG_timeout, BLINK_INTERVAL, 0);
+			blink_task_id = SCH_Add_Task(LCDMNG_timeout_for_blink, BLINK_INTERVAL, 0);
 		}
 	}
 
 }
 
+// Only the cursor cell is resent, the framebuffer is left alone
 static void LCDMNG_blink(){
-	static bool blink = false;
-	uint8_t x = blink_x_position;
-	uint8_t line = blink_line_position;
-	uint8_t* _blink_font;
-	if(blink){
-		_blink_font = black7x15;
-	}else{
-		_blink_font = white7x15;
-	}
-	uint8_t xOffset = 7;
-	uint8_t yOffset = 15 / 8 + 1;
-	for (uint8_t i = 0; i < xOffset; i++) {
-		for (uint8_t j = 0; j < yOffset; j++) {
-			_blink_font[x + ((line + j) * 128)] = font[6 + j * xOffset + i];
-		}
-		x++;
+	if(curr_screen == LCDMNG_SCREEN_NONE){
+		return;
 	}
+	blink_on = !blink_on;
+	LCD_show_overlay(LCDMNG_OVERLAY_CURSOR, blink_on);
 }
 
 static void LCDMNG_set_blink(size_t x_position, size_t line_position){
-	blink_x_position = x_position;
-	blink_line_position = line_position;
+	// Moving the overlay hides it, the next tick shows it at the new cell
+	LCD_set_overlay(LCDMNG_OVERLAY_CURSOR, x_position, line_position * 8, BLINK_WIDTH, BLINK_HEIGHT);
+	blink_on = false;
+	if(!blink_enable){
+		timeout_for_blink = false;
+		blink_task_id = SCH_Add_Task(LCDMNG_timeout_for_blink, BLINK_INTERVAL, 0);
+	}
 	blink_enable = true;
 }
 
 static void LCDMNG_clear_blink(){
+	if(blink_enable){
+		SCH_Delete_Task(blink_task_id);
+	}
 	blink_enable = false;
+	blink_on = false;
+	timeout_for_blink = false;
+	LCD_show_overlay(LCDMNG_OVERLAY_CURSOR, false);
+}
+
+// Cursor on the cell after the last character, in the cell size of the layer the widget is drawn on
+static void LCDMNG_blink_after(const LCDMNG_widget_t *widget){
+	char number_buf[LCDMNG_NUMBER_BUFFER_SIZE];
+	size_t len = strlen(LCDMNG_widget_text(widget, number_buf));
+	size_t x = widget->x;
+	if(LCDMNG_pick_layer(widget, len) == LCDMNG_LAYER_TEXT){
+		x += len * LCD_TEXT_CELL_WIDTH;
+	}else{
+		x += len * (widget->font[2] + 1);
+	}
+	if(x + BLINK_WIDTH > LCDMNG_WIDTH){
+		LCDMNG_clear_blink();
+		return;
+	}
+	LCDMNG_set_blink(x, widget->line);
 }
 
 void LCDMNG_set_init_screen(){
@@ -1374,66 +976,43 @@ void LCDMNG_set_init_screen(){
 }
 
 void LCDMNG_set_working_screen_without_draw(RTC_t * rtc, uint32_t amount){
-	// Set Time
-	uint8_t hour = rtc->hour;
-	uint8_t minute = rtc->minute;
-	uint8_t second = rtc->second;
-	char time_buf[10];
-	snprintf(time_buf, sizeof(time_buf), "%02d:%02d", hour, minute);
-	LCDMNG_set_font(font15x31);
-	LCDMNG_draw_string(working_screen_temp, WORKING_SCREEN_TIME_X_POSITION, WORKING_SCREEN_TIME_LINE_POSITION, time_buf);
-	// Set Time
-	uint8_t date = rtc->date;
-	uint8_t month = rtc->month;
-	uint16_t year = rtc->year;
-	char date_buf[20];
-	snprintf(date_buf, sizeof(date_buf), "%02d/%02d/%04d", date, month, year);
-	LCDMNG_set_font(font5x7);
-	LCDMNG_draw_string(working_screen_temp, WORKING_SCREEN_DATE_X_POSITION, WORKING_SCREEN_DATE_LINE_POSITION, date_buf);
-	// Set card_price
-	char amount_buf[10];
-	snprintf(amount_buf, sizeof(amount_buf), "%d.000", amount / 1000);
-	LCDMNG_set_font(font7x15);
-	LCDMNG_draw_string(working_screen_temp, WORKING_SCREEN_AMOUNT_X_POSITION, WORKING_SCREEN_AMOUNT_LINE_POSITION, amount_buf);
+	char *c;
+	// Set Time, HH:MM
+	c = LCDMNG_format_digits(time_text, rtc->hour, 2);
+	*c++ = ':';
+	c = LCDMNG_format_digits(c, rtc->minute, 2);
+	*c = 0;
+	// Set Date, DD/MM/YYYY
+	c = LCDMNG_format_digits(date_text, rtc->date, 2);
+	*c++ = '/';
+	c = LCDMNG_format_digits(c, rtc->month, 2);
+	*c++ = '/';
+	c = LCDMNG_format_digits(c, rtc->year, 4);
+	*c = 0;
+	// Set amount
+	working_widgets[LCDMNG_WORKING_WIDGET_AMOUNT].value = amount / 1000;
 }
 
 void LCDMNG_set_working_screen(RTC_t * rtc, uint32_t amount){
-	memcpy(working_screen_temp, working_screen, sizeof(working_screen));
-	// Set Time
-	uint8_t hour = rtc->hour;
-	uint8_t minute = rtc->minute;
-	uint8_t second = rtc->second;
-	char time_buf[10];
-	snprintf(time_buf, sizeof(time_buf), "%02d:%02d", hour, minute);
-	LCDMNG_set_font(font15x31);
-	LCDMNG_draw_string(working_screen_temp, WORKING_SCREEN_TIME_X_POSITION, WORKING_SCREEN_TIME_LINE_POSITION, time_buf);
-	// Set Time
-	uint8_t date = rtc->date;
-	uint8_t month = rtc->month;
-	uint16_t year = rtc->year;
-	char date_buf[20];
-	snprintf(date_buf, sizeof(date_buf), "%02d/%02d/%04d", date, month, year);
-	LCDMNG_set_font(font5x7);
-	LCDMNG_draw_string(working_screen_temp, WORKING_SCREEN_DATE_X_POSITION, WORKING_SCREEN_DATE_LINE_POSITION, date_buf);
-	// Set card_price
-	char amount_buf[10];
-	snprintf(amount_buf, sizeof(amount_buf), "%d.000", amount / 1000);
-	LCDMNG_set_font(font7x15);
-	LCDMNG_draw_string(working_screen_temp, WORKING_SCREEN_AMOUNT_X_POSITION, WORKING_SCREEN_AMOUNT_LINE_POSITION, amount_buf);
-	LCD_draw_bitmap(working_screen_temp);
+	LCDMNG_set_working_screen_without_draw(rtc, amount);
+	if(curr_screen == LCDMNG_SCREEN_WORKING){
+		// Only the glyph cells which changed
+		for (uint8_t i = 0; i < LCDMNG_WORKING_WIDGET_MAX; ++i) {
+			LCDMNG_update_widget(LCDMNG_SCREEN_WORKING, i);
+		}
+	}else{
+		LCDMNG_show(LCDMNG_SCREEN_WORKING);
+	}
 }
 
 
 void LCDMNG_set_password_screen(uint8_t *password, size_t password_len, uint8_t passwd_state, bool success){
 	// State: 0 is not pressed, 1 is pressed password but not entered, 2 is entered
 	// Success if entered and password correct otherwise is false
-	size_t padlen;
-	uint8_t password_buf[128];
-	uint8_t star_buf[128];
+	uint8_t star_buf[LCDMNG_TEXT_SIZE];
 	char * password_wrong = "Sai mat khau";
-	memset(password_screen, 0 , sizeof(password_screen));
-	LCDMNG_set_font(font5x7);
-	LCDMNG_draw_string(password_screen, PASSWORD_SCREEN_X_POSITION, PASSWORD_SCREEN_LINE_POSITION, "Password");
+	LCDMNG_widget_t *data_widget = &password_widgets[LCDMNG_PASSWORD_WIDGET_DATA];
+	data_widget->visible = false;
 	switch (passwd_state) {
 		case 0:
 			// Not Pressed -> Just show password screen title
@@ -1442,41 +1021,37 @@ void LCDMNG_set_password_screen(uint8_t *password, size_t password_len, uint8_t
 		case 1:
 			// Show password as ***
 			memset(star_buf, 0, sizeof(star_buf));
-			memset(star_buf, '*', password_len);
-			padlen = (24 - password_len) / 2 - 1;
-			snprintf(password_buf, sizeof(password_buf), "%*s%s%*s", padlen, "", star_buf , padlen, "");
-			LCDMNG_draw_string(password_screen, PASSWORD_DATA_SCREEN_X_POSITION, PASSWORD_DATA_SCREEN_LINE_POSITION, password_buf);
+			memset(star_buf, '*', password_len < sizeof(star_buf) ? password_len : sizeof(star_buf) - 1);
+			LCDMNG_center_text(password_text, sizeof(password_text), data_widget, (char *)star_buf);
+			data_widget->visible = true;
 			break;
 		case 2:
 			// Show password result is success or failed
 			if(!success){
-				padlen = (24 - strlen(password_wrong)) / 2 - 1;
-				snprintf(password_buf, sizeof(password_buf), "%*s%s%*s", padlen, "", password_wrong , padlen, "");
-				LCDMNG_draw_string(password_screen, PASSWORD_DATA_SCREEN_X_POSITION, PASSWORD_DATA_SCREEN_LINE_POSITION, password_buf);
+				LCDMNG_center_text(password_text, sizeof(password_text), data_widget, password_wrong);
+				data_widget->visible = true;
 			}
 			break;
 		default:
 			break;
 	}
-	LCD_draw_bitmap(password_screen);
+	LCDMNG_show(LCDMNG_SCREEN_PASSWORD);
+	if(passwd_state == 1){
+		LCDMNG_blink_after(data_widget);
+	}else{
+		LCDMNG_clear_blink();
+	}
 	password_enable = true;
 }
 
 void LCDMNG_clear_password_screen(){
+	LCDMNG_clear_blink();
 	password_enable = false;
 }
 
 void LCDMNG_set_setting_screen(){
-	// Update argument
-	char str_buf[20];
-	for (int field_id = LCDMNG_SETTING_FIELD_DATE_TIME; field_id <= LCDMNG_SETTING_FIELD_DELETE_TOTAL_AMOUNT; ++field_id) {
-		memset(str_buf, 0 , sizeof(str_buf));
-		sniprintf(str_buf, sizeof(str_buf), "%d %s", field_id, setting_field_info[field_id].name);
-		LCDMNG_set_font(font5x7);
-		LCDMNG_draw_string(setting_screen, setting_field_info[field_id].x_position, setting_field_info[field_id].line_position, str_buf);
-	}
 	// Do nothing with argument
-	LCD_draw_bitmap(setting_screen);
+	LCDMNG_show(LCDMNG_SCREEN_SETTING);
 	setting_enable = true;
 }
 
@@ -1485,12 +1060,12 @@ void LCDMNG_clear_setting_screen(){
 }
 
 void LCDMNG_set_setting_data_screen(uint32_t field_id, void * data, size_t data_len, uint8_t state){
-	memset(setting_data_screen, 0, sizeof(setting_data_screen));
-	char field_buf[20];
 	size_t padlen = (22 - strlen(setting_field_info[field_id].name)) / 2;
-	snprintf(field_buf, sizeof(field_buf), "%*s%s%*s", padlen, "", setting_field_info[field_id].name, padlen, "");
-	LCDMNG_set_font(font5x7);
-	LCDMNG_draw_string(setting_data_screen, 0,0, field_buf);
+	// Same width as the old 20 bytes title buffer
+	snprintf(setting_data_title_text, 20, "%*s%s%*s", (int)padlen, "", setting_field_info[field_id].name, (int)padlen, "");
+	for (uint8_t i = 0; i < LCDMNG_SETTING_DATA_LINE_MAX; ++i) {
+		setting_data_widgets[LCDMNG_SETTING_DATA_WIDGET_LINE + i].visible = false;
+	}
 	switch (field_id) {
 		case LCDMNG_SETTING_FIELD_DATE_TIME:
 			LCDMNG_setting_data_time(data, data_len, state);
@@ -1516,11 +1091,19 @@ void LCDMNG_set_setting_data_screen(uint32_t field_id, void * data, size_t data_
 		default:
 			break;
 	}
-	LCD_draw_bitmap(setting_data_screen);
+	LCDMNG_show(LCDMNG_SCREEN_SETTING_DATA);
+	// Only the card price and the password are typed in digit by digit
+	if(state == LCDMNG_SETTING_DATA_NOT_ENTERED
+			&& (field_id == LCDMNG_SETTING_FIELD_CARD_PRICE || field_id == LCDMNG_SETTING_FIELD_PASSWORD)){
+		LCDMNG_blink_after(&setting_data_widgets[LCDMNG_SETTING_DATA_WIDGET_LINE]);
+	}else{
+		LCDMNG_clear_blink();
+	}
 	setting_data_enable = true;
 }
 
 void LCDMNG_clear_setting_data_screen(){
+	LCDMNG_clear_blink();
 	setting_data_enable = false;
 }
 
@@ -1557,7 +1140,124 @@ void LCDMNG_clear_card_error_screen(){
 }
 
 void LCDMNG_test(){
-	LCD_draw_bitmap(welcome_screen);
+	LCDMNG_show(LCDMNG_SCREEN_WELCOME);
+}
+
+/**
+ * Draw every screen with fixed content, the working screen a second
+ * time with new values updated in place. frame_done is called with the name
+ * of each frame once it is on the glass, Tools/lcdemu checks them
+ * against its golden images and keeps the bytes per frame.
+ */
+void LCDMNG_draw_screens(LCDMNG_frame_done_t frame_done){
+	RTC_t rtc = {
+			.second = 0,
+			.minute = 34,
+			.hour = 12,
+			.date = 1,
+			.month = 6,
+			.year = 2023
+	};
+	uint8_t password[] = "123456";
+	uint32_t card_price = 5000;
+	LCD_flush();
+	LCD_invalidate();
+	for (uint8_t screen_id = LCDMNG_SCREEN_LOGO; screen_id < LCDMNG_SCREEN_MAX; ++screen_id) {
+		LCD_reset_stats();
+		switch (screen_id) {
+			case LCDMNG_SCREEN_WORKING:
+				LCDMNG_set_working_screen_without_draw(&rtc, 25000);
+				LCDMNG_show(screen_id);
+				break;
+			case LCDMNG_SCREEN_PASSWORD:
+				LCDMNG_set_password_screen(password, sizeof(password) - 1, 1, false);
+				break;
+			case LCDMNG_SCREEN_SETTING_DATA:
+				LCDMNG_set_setting_data_screen(LCDMNG_SETTING_FIELD_CARD_PRICE, &card_price, sizeof(card_price), LCDMNG_SETTING_DATA_NOT_ENTERED);
+				LCDMNG_clear_setting_data_screen();
+				break;
+			default:
+				LCDMNG_show(screen_id);
+				break;
+		}
+		LCD_flush();
+		frame_done(lcdmng_screen_name[screen_id]);
+		if(screen_id == LCDMNG_SCREEN_WORKING){
+			// New values, only the changed glyph cells are sent
+			LCD_reset_stats();
+			rtc.minute = 35;
+			LCDMNG_set_working_screen(&rtc, 30000);
+			LCD_flush();
+			frame_done("working_update");
+		}
+		if(screen_id == LCDMNG_SCREEN_PASSWORD){
+			// First blink tick, only the rows under the cursor are sent
+			LCD_reset_stats();
+			LCDMNG_blink();
+			LCD_flush();
+			frame_done("password_cursor");
+			LCDMNG_clear_password_screen();
+		}
+	}
+}
+
+/**
+ * Snapshot of the draws, bus traffic and timeouts per state and screen
+ * since boot or LCDMNG_reset_metrics(). Draws climbing on the working and
+ * card screens between two snapshots point at a flapping TCD input.
+ */
+void LCDMNG_get_metrics(LCDMNG_metrics_t *metrics_p){
+	LCDMNG_account_bus();
+	memcpy(metrics_p, &metrics, sizeof(metrics));
+}
+
+void LCDMNG_reset_metrics(){
+	LCDMNG_account_bus();
+	memset(&metrics, 0, sizeof(metrics));
+	metrics.since = HAL_GetTick();
+}
+
+void LCDMNG_log_metrics(){
+	LCDMNG_account_bus();
+	utils_log_info("LCDMNG_metrics: %d ms\r\n", HAL_GetTick() - metrics.since);
+	for (uint8_t screen_id = LCDMNG_SCREEN_LOGO; screen_id < LCDMNG_SCREEN_MAX; ++screen_id) {
+		LCDMNG_screen_metrics_t *screen = &metrics.screens[screen_id];
+		utils_log_info("LCDMNG_metrics: %-12s draws %d updates %d bytes %d bus %d us compose %d us\r\n",
+						lcdmng_screen_name[screen_id],
+						screen->draws,
+						screen->updates,
+						screen->bytes,
+						screen->bus_us,
+						screen->compose_us);
+	}
+	for (uint8_t state_id = LCDMNG_STATE_INIT; state_id < LCDMNG_STATE_MAX; ++state_id) {
+		LCDMNG_state_metrics_t *state_metrics = &metrics.states[state_id];
+		// State names end the line
+		utils_log_info("LCDMNG_metrics: entries %d draws %d timeouts %d leaked %d %s",
+						state_metrics->entries,
+						state_metrics->draws,
+						state_metrics->timeouts_scheduled,
+						state_metrics->timeouts_leaked,
+						lcdmng_state_name[state_id]);
+	}
+}
+
+/**
+ * Frames are sent from LCD_flush() after LCDMNG_show() returns, so the
+ * bus counters are charged to the screen shown while they grew.
+ */
+static void LCDMNG_account_bus(){
+	LCD_stats_t *stats = LCD_get_stats();
+	uint32_t bytes = stats->total_bytes + stats->text_bytes;
+	if(bytes < metrics_bus_bytes || stats->total_us < metrics_bus_us){
+		// LCD stats were reset
+		metrics_bus_bytes = 0;
+		metrics_bus_us = 0;
+	}
+	metrics.screens[curr_screen].bytes += bytes - metrics_bus_bytes;
+	metrics.screens[curr_screen].bus_us += stats->total_us - metrics_bus_us;
+	metrics_bus_bytes = bytes;
+	metrics_bus_us = stats->total_us;
 }
 
 static void LCDMNG_setting_data_time(void * data, size_t data_len, uint8_t state){
@@ -1580,7 +1280,7 @@ static void LCDMNG_setting_data_time(void * data, size_t data_len, uint8_t state
 		default:
 			break;
 	}
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
 }
 static void LCDMNG_setting_data_card_price(void * data, size_t data_len, uint8_t state){
 	char data_buf[20];
@@ -1598,7 +1298,7 @@ static void LCDMNG_setting_data_card_price(void * data, size_t data_len, uint8_t
 		default:
 			break;
 	}
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
 }
 static void LCDMNG_setting_data_password(void * data, size_t data_len, uint8_t state){
 	char data_buf[20];
@@ -1616,18 +1316,18 @@ static void LCDMNG_setting_data_password(void * data, size_t data_len, uint8_t s
 		default:
 			break;
 	}
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
 }
 static void LCDMNG_setting_data_total_card(void * data, size_t data_len, uint8_t state){
 	char data_buf[20];
 	uint32_t total_card[3];
 	memcpy(total_card, data, sizeof(total_card));
 	snprintf(data_buf, sizeof(data_buf), "Hom nay:     %d", total_card[1]);
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION - 5, SETTING_SCREEN_DATA_LINE_POSITION -1, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION - 5, SETTING_SCREEN_DATA_LINE_POSITION -1, data_buf);
 	snprintf(data_buf, sizeof(data_buf), "Thang nay:   %d", total_card[2]);
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION - 5 , SETTING_SCREEN_DATA_LINE_POSITION+1, data_buf);
+	LCDMNG_set_setting_data_line(1, SETTING_SCREEN_DATA_X_POSITION - 5 , SETTING_SCREEN_DATA_LINE_POSITION+1, data_buf);
 	snprintf(data_buf, sizeof(data_buf), "Tong:        %d", total_card[0]);
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION - 5, SETTING_SCREEN_DATA_LINE_POSITION+3, data_buf);
+	LCDMNG_set_setting_data_line(2, SETTING_SCREEN_DATA_X_POSITION - 5, SETTING_SCREEN_DATA_LINE_POSITION+3, data_buf);
 }
 static void LCDMNG_setting_data_delete_total_card(void * data, size_t data_len, uint8_t state){
 	char data_buf[20];
@@ -1642,7 +1342,7 @@ static void LCDMNG_setting_data_delete_total_card(void * data, size_t data_len,
 		default:
 			break;
 	}
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
 }
 static void LCDMNG_setting_data_total_amount(void * data, size_t data_len, uint8_t state){
 	char data_buf[20];
@@ -1656,7 +1356,7 @@ static void LCDMNG_setting_data_total_amount(void * data, size_t data_len, uint8
 		default:
 			break;
 	}
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION + 1, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION + 1, data_buf);
 }
 static void LCDMNG_setting_data_delete_total_amount(void * data, size_t data_len, uint8_t state){
 	char data_buf[20];
@@ -1671,11 +1371,174 @@ static void LCDMNG_setting_data_delete_total_amount(void * data, size_t data_len
 		default:
 			break;
 	}
-	LCDMNG_draw_string(setting_data_screen, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
+	LCDMNG_set_setting_data_line(0, SETTING_SCREEN_DATA_X_POSITION, SETTING_SCREEN_DATA_LINE_POSITION, data_buf);
+}
+
+
+static void LCDMNG_show(uint8_t screen_id){
+	uint32_t start = DWT->CYCCNT;
+	// Bus traffic so far belongs to the screen being replaced
+	LCDMNG_account_bus();
+	curr_screen = screen_id;
+	LCDMNG_compose(screen_id);
+	metrics.screens[screen_id].compose_us += (DWT->CYCCNT - start) / (SystemCoreClock / 1000000);
+	metrics.screens[screen_id].draws++;
+	metrics.states[state].draws++;
+	LCD_draw_bitmap(framebuffer);
+	LCD_draw_text(text_frame);
+}
+
+/**
+ * Background from flash, then the visible widgets. The blink cursor is
+ * an LCD overlay, not part of the frame. The renderer only sends what
+ * changed on the glass.
+ */
+static void LCDMNG_compose(uint8_t screen_id){
+	const LCDMNG_screen_t *screen = &screens[screen_id];
+	LCDMNG_widget_t *widget;
+	const char *text;
+	char number_buf[LCDMNG_NUMBER_BUFFER_SIZE];
+	memset(framebuffer, 0, SCREEN_SIZE);
+	memset(text_frame, ' ', LCD_TEXT_SIZE);
+	if(screen->background != NULL){
+		LCDMNG_draw_image(framebuffer, screen->background);
+	}
+	for (size_t i = 0; i < screen->widget_count; ++i) {
+		widget = &screen->widgets[i];
+		if(widget->drawn != NULL){
+			widget->drawn[0] = 0;
+		}
+		if(!widget->visible){
+			continue;
+		}
+		text = LCDMNG_widget_text(widget, number_buf);
+		if(LCDMNG_pick_layer(widget, strlen(text)) == LCDMNG_LAYER_TEXT){
+			memcpy(&text_frame[(widget->line * 8 / LCD_TEXT_CELL_HEIGHT) * LCD_TEXT_COLUMNS
+								+ widget->x / LCD_TEXT_CELL_WIDTH], text, strlen(text));
+		}else{
+			LCDMNG_set_font(widget->font);
+			LCDMNG_draw_string(framebuffer, widget->x, widget->line, text);
+		}
+		if(widget->drawn != NULL){
+			snprintf(widget->drawn, LCDMNG_NUMBER_BUFFER_SIZE, "%s", text);
+		}
+	}
+}
+
+/**
+ * Redraw only the glyph cells of a widget whose character changed, then
+ * queue just the rows of the field. The fonts are stored in the
+ * controller layout, so each cell is a straight row copy. Falls back to
+ * a full compose when the length changes or the text would wrap.
+ */
+static void LCDMNG_update_widget(uint8_t screen_id, uint8_t widget_id){
+	LCDMNG_widget_t *widget = &screens[screen_id].widgets[widget_id];
+	char number_buf[LCDMNG_NUMBER_BUFFER_SIZE];
+	const char *text;
+	size_t len;
+	uint8_t x = widget->x;
+	uint8_t y = widget->line * 8;
+	bool changed = false;
+	if(curr_screen != screen_id){
+		return;
+	}
+	text = LCDMNG_widget_text(widget, number_buf);
+	len = strlen(text);
+	if(widget->drawn == NULL
+			|| !widget->visible
+			|| LCDMNG_pick_layer(widget, len) != LCDMNG_LAYER_GRAPHIC
+			|| len != strlen(widget->drawn)
+			|| (len > 0 && widget->x + (len - 1) * (widget->font[2] + 1) + 6 >= LCDMNG_WIDTH)){
+		LCDMNG_show(screen_id);
+		return;
+	}
+	LCDMNG_set_font(widget->font);
+	for (size_t i = 0; i < len; ++i) {
+		if(text[i] != widget->drawn[i]){
+			LCDMNG_draw_char(framebuffer, x, widget->line, text[i]);
+			widget->drawn[i] = text[i];
+			changed = true;
+		}
+		x += font[2] + 1;
+	}
+	if(changed){
+		LCD_draw_region(framebuffer, y, y + (font[3] / 8 + 1) * 8);
+		metrics.screens[screen_id].updates++;
+	}
+}
+
+/**
+ * Layout: a widget asking for the text layer gets it when it sits on the
+ * 8x16 grid and fits its row, otherwise it falls back to pixels. For
+ * LCDMNG_LAYER_AUTO the bus bytes are compared: the text layer costs the
+ * two instruction set switches, a DDRAM address and the character pairs,
+ * the graphic layer a GDRAM address and the spanned words per pixel row.
+ */
+static uint8_t LCDMNG_pick_layer(const LCDMNG_widget_t *widget, size_t len){
+	size_t column = widget->x / LCD_TEXT_CELL_WIDTH;
+	size_t rows;
+	size_t text_cost;
+	size_t graphic_cost;
+	if(widget->layer == LCDMNG_LAYER_GRAPHIC || len == 0){
+		return LCDMNG_LAYER_GRAPHIC;
+	}
+	if(widget->x % LCD_TEXT_CELL_WIDTH != 0
+			|| (widget->line * 8) % LCD_TEXT_CELL_HEIGHT != 0
+			|| column + len > LCD_TEXT_COLUMNS){
+		return LCDMNG_LAYER_GRAPHIC;
+	}
+	if(widget->layer == LCDMNG_LAYER_TEXT){
+		return LCDMNG_LAYER_TEXT;
+	}
+	text_cost = 3 + ((column + len + 1) / 2 - column / 2) * 2;
+	rows = (widget->font[3] / 8 + 1) * 8;
+	graphic_cost = rows * (2 + ((widget->x + len * (widget->font[2] + 1) + 15) / 16 - widget->x / 16) * 2);
+	return text_cost < graphic_cost ? LCDMNG_LAYER_TEXT : LCDMNG_LAYER_GRAPHIC;
 }
 
+// Characters which fit the rest of the widget line on its preferred layer
+static size_t LCDMNG_columns(const LCDMNG_widget_t *widget){
+	if(widget->layer != LCDMNG_LAYER_GRAPHIC
+			&& widget->x % LCD_TEXT_CELL_WIDTH == 0
+			&& (widget->line * 8) % LCD_TEXT_CELL_HEIGHT == 0){
+		return LCD_TEXT_COLUMNS - widget->x / LCD_TEXT_CELL_WIDTH;
+	}
+	return (LCDMNG_WIDTH - widget->x) / (widget->font[2] + 1);
+}
 
-static void LCDMNG_draw_string(uint8_t *buff, uint8_t x, uint8_t line, uint8_t *c) {
+static void LCDMNG_center_text(char *buf, size_t size, const LCDMNG_widget_t *widget, const char *text){
+	size_t columns = LCDMNG_columns(widget);
+	size_t len = strlen(text);
+	size_t padlen = columns > len ? (columns - len) / 2 : 0;
+	snprintf(buf, size, "%*s%s", (int)padlen, "", text);
+}
+
+static const char * LCDMNG_widget_text(const LCDMNG_widget_t *widget, char *number_buf){
+	if(widget->type == LCDMNG_WIDGET_NUMBER){
+		snprintf(number_buf, LCDMNG_NUMBER_BUFFER_SIZE, widget->text, widget->value);
+		return number_buf;
+	}
+	return widget->text;
+}
+
+// Zero padded decimal without printf, returns the end of the digits
+static char * LCDMNG_format_digits(char *buf, uint32_t value, uint8_t digits){
+	for (int8_t i = digits - 1; i >= 0; --i) {
+		buf[i] = '0' + value % 10;
+		value /= 10;
+	}
+	return buf + digits;
+}
+
+static void LCDMNG_set_setting_data_line(uint8_t index, uint8_t x, uint8_t line, const char *text){
+	LCDMNG_widget_t *widget = &setting_data_widgets[LCDMNG_SETTING_DATA_WIDGET_LINE + index];
+	strncpy(setting_data_text[index], text, LCDMNG_TEXT_SIZE - 1);
+	widget->x = x;
+	widget->line = line;
+	widget->visible = true;
+}
+
+static void LCDMNG_draw_string(uint8_t *buff, uint8_t x, uint8_t line, const char *c) {
 	while (c[0] != 0) {
 		LCDMNG_draw_char(buff, x, line, c[0]);
 		c++;
@@ -1689,27 +1552,74 @@ static void LCDMNG_draw_string(uint8_t *buff, uint8_t x, uint8_t line, uint8_t *
 	}
 }
 
-static void LCDMNG_set_font(uint8_t *fontPtr) {
+static void LCDMNG_set_font(const uint8_t *fontPtr) {
 	font = fontPtr;
 }
 
+/**
+ * Glyphs are stored in native layout: (height / 8 + 1) * 8 rows of
+ * (width + 7) / 8 bytes, each row replaces the cell under it.
+ */
 static void LCDMNG_draw_char(uint8_t *buff, uint8_t x, uint8_t line, uint8_t c) {
-	uint8_t xOffset = font[2];
-	uint8_t yOffset = font[3] / 8 + 1;
-	c -= font[4];
-	c = c * yOffset;
-	for (uint8_t i = 0; i < xOffset; i++) {
-		for (uint8_t j = 0; j < yOffset; j++) {
-			buff[x + ((line + j) * 128)] = font[6 + ((c + j) * xOffset) + i];
+	uint8_t width = font[2];
+	uint8_t height = (font[3] / 8 + 1) * 8;
+	uint8_t row_bytes = (width + 7) / 8;
+	const uint8_t *glyph = &font[6 + (c - font[4]) * height * row_bytes];
+	uint32_t bits;
+	for (uint8_t y = line * 8; y < line * 8 + height && y < LCDMNG_HEIGHT; y++) {
+		bits = 0;
+		for (uint8_t i = 0; i < 4; i++) {
+			bits <<= 8;
+			if(i < row_bytes){
+				bits |= glyph[i];
+			}
 		}
-		x++;
+		LCDMNG_draw_row(buff, x, y, bits, width);
+		glyph += row_bytes;
+	}
+}
+
+// Copy the leftmost width bits of bits (MSB first) to row y starting at pixel x
+static void LCDMNG_draw_row(uint8_t *buff, uint8_t x, uint8_t y, uint32_t bits, uint8_t width) {
+	uint32_t mask = 0xFFFFFFFF << (32 - width);
+	uint8_t *row = &buff[y * LCD_ROW_BYTES];
+	bits = (bits & mask) >> (x % 8);
+	mask >>= x % 8;
+	for (uint8_t i = x / 8; i < LCD_ROW_BYTES && mask; i++) {
+		row[i] = (row[i] & ~(mask >> 24)) | (bits >> 24);
+		bits <<= 8;
+		mask <<= 8;
 	}
 }
 
 static void LCDMNG_timeout(){
+	timeout_pending = false;
 	timeout = true;
 }
 
+/**
+ * Arm the screen timeout on behalf of the running state. One still
+ * pending would fire early in the next state, it is cancelled and
+ * counted as leaked against the state which armed it.
+ */
+static void LCDMNG_start_timeout(uint32_t duration){
+	if(timeout_pending){
+		SCH_Delete_Task(timeout_task_id);
+		metrics.states[timeout_state].timeouts_leaked++;
+	}
+	timeout_task_id = SCH_Add_Task(LCDMNG_timeout, duration, 0);
+	timeout_pending = true;
+	timeout_state = state;
+	metrics.states[state].timeouts_scheduled++;
+}
+
+static void LCDMNG_cancel_timeout(){
+	if(timeout_pending){
+		SCH_Delete_Task(timeout_task_id);
+		timeout_pending = false;
+	}
+}
+
 
 static void LCDMNG_timeout_for_blink(){
 	timeout_for_blink = true;
@@ -7,37 +7,168 @@
 
 
 #include "main.h"
+#include "string.h"
 #include "Hal/i2c.h"
+#include "Hal/timer.h"
 
+#define I2C_SCL_PIN				GPIO_PIN_6
+#define I2C_SDA_PIN				GPIO_PIN_7
+#define I2C_GPIO_PORT			GPIOB
+#define I2C_RECOVERY_CLOCKS		9
+#define I2C_RECOVERY_HALF_PERIOD_US		5	// 100kHz
+
+enum {
+	I2C_STATE_IDLE,
+	I2C_STATE_BUSY,
+	I2C_STATE_DONE,
+	I2C_STATE_ERROR
+};
+
+typedef struct {
+	volatile bool done;
+	volatile bool success;
+}I2C_sync_t;
 
 I2C_HandleTypeDef hi2c1;
 
+// Request queue
+static I2C_request_t request_queue[I2C_REQUEST_QUEUE_SIZE];
+static size_t queue_head = 0;
+static size_t queue_len = 0;
+static volatile uint8_t state = I2C_STATE_IDLE;
+static uint32_t request_start;
+static uint32_t clock_speed = I2C_STANDARD_MODE_SPEED;
+
+static void I2C_config(uint32_t speed);
+static bool I2C_start(I2C_request_t * request);
+static void I2C_finish(bool success);
+static bool I2C_transfer(I2C_request_t * request);
+static void I2C_sync_cb(bool success, void * arg);
+static void I2C_delay_us(uint32_t us);
+
 void I2C_init(){
-	hi2c1.Instance = I2C1;
-	hi2c1.Init.ClockSpeed = 100000;
-	hi2c1.Init.DutyCycle = I2C_DUTYCYCLE_2;
-	hi2c1.Init.OwnAddress1 = 0;
-	hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
-	hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
-	hi2c1.Init.OwnAddress2 = 0;
-	hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
-	hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
-	if (HAL_I2C_Init(&hi2c1) != HAL_OK)
-	{
-	Error_Handler();
+	I2C_config(I2C_STANDARD_MODE_SPEED);
+}
+
+/**
+ * Start next queued request and check timeout of the request in flight.
+ * Called from the superloop for I2C_submit callers, the blocking helpers
+ * also call it while they wait.
+ */
+void I2C_run(){
+	I2C_request_t * request;
+	switch (state) {
+		case I2C_STATE_BUSY:
+			request = &request_queue[queue_head];
+			if(HAL_GetTick() - request_start > request->timeout){
+				// Stuck transfer -> Abort and release bus
+				I2C_recover_bus();
+				I2C_finish(false);
+			}
+			break;
+		case I2C_STATE_DONE:
+			I2C_finish(true);
+			break;
+		case I2C_STATE_ERROR:
+			// NACK is normal on EEPROM ack polling, only recover when bus is held
+			if(HAL_I2C_GetError(&hi2c1) & (HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_ARLO)){
+				I2C_recover_bus();
+			}
+			I2C_finish(false);
+			break;
+		case I2C_STATE_IDLE:
+		default:
+			break;
+	}
+	while(state == I2C_STATE_IDLE && queue_len > 0){
+		request = &request_queue[queue_head];
+		if(I2C_start(request)){
+			break;
+		}
+		I2C_finish(false);
 	}
 }
 
+bool I2C_submit(I2C_request_t * request){
+	if(queue_len >= I2C_REQUEST_QUEUE_SIZE){
+		return false;
+	}
+	I2C_request_t * slot = &request_queue[(queue_head + queue_len) % I2C_REQUEST_QUEUE_SIZE];
+	memcpy(slot, request, sizeof(I2C_request_t));
+	if(slot->timeout == 0){
+		slot->timeout = I2C_TIMEOUT;
+	}
+	queue_len++;
+	I2C_run();
+	return true;
+}
+
+bool I2C_is_idle(){
+	return state == I2C_STATE_IDLE && queue_len == 0;
+}
+
+/**
+ * Clock SCL until the slave releases SDA, then generate STOP and reset the peripheral
+ */
+bool I2C_recover_bus(){
+	GPIO_InitTypeDef gpio = {
+		.Pin = I2C_SCL_PIN | I2C_SDA_PIN,
+		.Mode = GPIO_MODE_OUTPUT_OD,
+		.Pull = GPIO_NOPULL,
+		.Speed = GPIO_SPEED_FREQ_HIGH
+	};
+	HAL_I2C_DeInit(&hi2c1);
+	HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN | I2C_SDA_PIN, GPIO_PIN_SET);
+	HAL_GPIO_Init(I2C_GPIO_PORT, &gpio);
+	for (uint8_t var = 0; var < I2C_RECOVERY_CLOCKS; ++var) {
+		if(HAL_GPIO_ReadPin(I2C_GPIO_PORT, I2C_SDA_PIN) == GPIO_PIN_SET){
+			break;
+		}
+		HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN, GPIO_PIN_RESET);
+		I2C_delay_us(I2C_RECOVERY_HALF_PERIOD_US);
+		HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN, GPIO_PIN_SET);
+		I2C_delay_us(I2C_RECOVERY_HALF_PERIOD_US);
+	}
+	// STOP condition: SDA low -> high while SCL high
+	HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SDA_PIN, GPIO_PIN_RESET);
+	I2C_delay_us(I2C_RECOVERY_HALF_PERIOD_US);
+	HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SDA_PIN, GPIO_PIN_SET);
+	I2C_delay_us(I2C_RECOVERY_HALF_PERIOD_US);
+	bool released = HAL_GPIO_ReadPin(I2C_GPIO_PORT, I2C_SDA_PIN) == GPIO_PIN_SET;
+	// Clear stuck BUSY flag (STM32F1 errata) and re-init
+	__HAL_RCC_I2C1_CLK_ENABLE();
+	SET_BIT(hi2c1.Instance->CR1, I2C_CR1_SWRST);
+	CLEAR_BIT(hi2c1.Instance->CR1, I2C_CR1_SWRST);
+	I2C_config(clock_speed);
+	return released;
+}
+
+bool I2C_is_device_ready(uint8_t address, uint32_t trials){
+	// Address-only probe is short, run it blocking once queue is drained
+	while(!I2C_is_idle()){
+		I2C_run();
+	}
+	return HAL_I2C_IsDeviceReady(&hi2c1, address, trials, I2C_TIMEOUT) == HAL_OK;
+}
+
 bool I2C_write(uint8_t address, uint8_t * data_w, size_t w_len){
-	// Write
-	bool success = HAL_I2C_Master_Transmit(&hi2c1, address, data_w, w_len, I2C_TIMEOUT) == HAL_OK;
-	return success;
+	I2C_request_t request = {
+		.address = address,
+		.data = data_w,
+		.data_len = w_len,
+		.is_read = false
+	};
+	return I2C_transfer(&request);
 }
 
 bool I2C_read(uint8_t address, uint8_t * data_r, size_t r_len){
-	// Read
-	bool success = HAL_I2C_Master_Receive(&hi2c1, address, data_r, r_len, I2C_TIMEOUT) == HAL_OK;
-	return success;
+	I2C_request_t request = {
+		.address = address,
+		.data = data_r,
+		.data_len = r_len,
+		.is_read = true
+	};
+	return I2C_transfer(&request);
 }
 
 bool I2C_write_and_read(uint8_t address, uint8_t * data_w, size_t w_len, uint8_t * data_r, size_t r_len){
@@ -48,18 +179,131 @@ bool I2C_write_and_read(uint8_t address, uint8_t * data_w, size_t w_len, uint8_t
 	return success;
 }
 
-
 bool I2C_mem_write(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_w, size_t w_len){
-	// Write
-	bool success = HAL_I2C_Mem_Write(&hi2c1, address, mem_address, mem_size, data_w, w_len, I2C_TIMEOUT);
-	return success;
+	I2C_request_t request = {
+		.address = address,
+		.mem_address = mem_address,
+		.mem_size = mem_size,
+		.data = data_w,
+		.data_len = w_len,
+		.is_read = false
+	};
+	return I2C_transfer(&request);
 }
 
-bool I2C_mem_read(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_w, size_t w_len){
-	// Write
-	bool success = HAL_I2C_Mem_Read(&hi2c1, address, mem_address, mem_size, data_w, w_len, I2C_TIMEOUT);
-	return success;
+bool I2C_mem_read(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_r, size_t r_len){
+	I2C_request_t request = {
+		.address = address,
+		.mem_address = mem_address,
+		.mem_size = mem_size,
+		.data = data_r,
+		.data_len = r_len,
+		.is_read = true
+	};
+	return I2C_transfer(&request);
+}
+
+// HAL callback
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c){
+	state = I2C_STATE_DONE;
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c){
+	state = I2C_STATE_DONE;
 }
 
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c){
+	state = I2C_STATE_DONE;
+}
 
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c){
+	state = I2C_STATE_DONE;
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+	state = I2C_STATE_ERROR;
+}
 
+// Private function
+static void I2C_config(uint32_t speed){
+	clock_speed = speed;
+	hi2c1.Instance = I2C1;
+	hi2c1.Init.ClockSpeed = speed;
+	hi2c1.Init.DutyCycle = I2C_DUTYCYCLE_2;
+	hi2c1.Init.OwnAddress1 = 0;
+	hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	hi2c1.Init.OwnAddress2 = 0;
+	hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+	if (HAL_I2C_Init(&hi2c1) != HAL_OK)
+	{
+	Error_Handler();
+	}
+}
+
+static bool I2C_start(I2C_request_t * request){
+	HAL_StatusTypeDef ret;
+	state = I2C_STATE_BUSY;
+	request_start = HAL_GetTick();
+	if(request->mem_size > 0){
+		if(request->is_read){
+			ret = HAL_I2C_Mem_Read_IT(&hi2c1, request->address, request->mem_address, request->mem_size, request->data, request->data_len);
+		}else{
+			ret = HAL_I2C_Mem_Write_IT(&hi2c1, request->address, request->mem_address, request->mem_size, request->data, request->data_len);
+		}
+	}else{
+		if(request->is_read){
+			ret = HAL_I2C_Master_Receive_IT(&hi2c1, request->address, request->data, request->data_len);
+		}else{
+			ret = HAL_I2C_Master_Transmit_IT(&hi2c1, request->address, request->data, request->data_len);
+		}
+	}
+	if(ret != HAL_OK){
+		state = I2C_STATE_IDLE;
+		return false;
+	}
+	return true;
+}
+
+static void I2C_finish(bool success){
+	I2C_request_t * request = &request_queue[queue_head];
+	I2C_callback_t callback = request->callback;
+	void * arg = request->arg;
+	queue_head = (queue_head + 1) % I2C_REQUEST_QUEUE_SIZE;
+	queue_len--;
+	state = I2C_STATE_IDLE;
+	if(callback){
+		callback(success, arg);
+	}
+}
+
+/**
+ * Blocking transfer, still goes through queue so it never collides with async requests
+ */
+static bool I2C_transfer(I2C_request_t * request){
+	I2C_sync_t sync = {
+		.done = false,
+		.success = false
+	};
+	request->callback = I2C_sync_cb;
+	request->arg = &sync;
+	while(!I2C_submit(request)){
+		I2C_run();
+	}
+	while(!sync.done){
+		I2C_run();
+	}
+	return sync.success;
+}
+
+static void I2C_sync_cb(bool success, void * arg){
+	I2C_sync_t * sync = (I2C_sync_t *)arg;
+	sync->success = success;
+	sync->done = true;
+}
+
+static void I2C_delay_us(uint32_t us){
+	uint32_t start = TIMER_get_tick_us();
+	while(TIMER_get_tick_us() - start < us);
+}
@@ -0,0 +1,215 @@
+/*
+ * arena.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+
+#include "string.h"
+#include "arena.h"
+#include "Lib/utils/utils_logger.h"
+
+enum {
+	ARENA_RECORD_FREE,			// Released, or padding up to the end of the buffer
+	ARENA_RECORD_LIVE
+};
+
+typedef struct {
+	uint16_t len;				// Header included, multiple of ARENA_ALIGN
+	uint8_t state;
+	uint8_t reserved;
+}ARENA_record_t;
+
+#define ARENA_HEADER_LEN		((sizeof(ARENA_record_t) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+#define ARENA_RECORD_LEN(len)	((ARENA_HEADER_LEN + (len) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+static ARENA_record_t * ARENA_record(ARENA_t *arena, uint16_t offset);
+static ARENA_record_t * ARENA_record_of(ARENA_t *arena, void *data);
+static void * ARENA_data(ARENA_record_t *record);
+static uint16_t ARENA_offset(ARENA_t *arena, ARENA_record_t *record);
+
+/**
+ * Records are taken at the tail and given back in any order, the space
+ * of a released record returns once every older one is released too.
+ * Records never wrap: the end of the buffer is padded when the next one
+ * does not fit there.
+ */
+void ARENA_init(ARENA_t *arena, uint8_t *buf, size_t size){
+	arena->buf = buf;
+	arena->size = size / ARENA_ALIGN * ARENA_ALIGN;
+	arena->head = 0;
+	arena->tail = 0;
+	arena->used = 0;
+	arena->count = 0;
+	arena->max_used = 0;
+	arena->failed = 0;
+}
+
+/**
+ * Contiguous room for len bytes at the tail, NULL when there is none.
+ * Nothing is queued until ARENA_commit, a reservation left alone is
+ * simply taken again by the next one.
+ */
+void * ARENA_reserve(ARENA_t *arena, size_t len){
+	size_t record_len = ARENA_RECORD_LEN(len);
+	ARENA_record_t *record;
+	if(arena->used > 0 && arena->tail == arena->head){
+		arena->failed++;
+		return NULL;
+	}
+	if(arena->tail >= arena->head){
+		if(arena->size - arena->tail < record_len){
+			if(arena->head < record_len){
+				arena->failed++;
+				return NULL;
+			}
+			// Pad the end, the record goes at the start
+			record = ARENA_record(arena, arena->tail);
+			record->len = arena->size - arena->tail;
+			record->state = ARENA_RECORD_FREE;
+			arena->used += record->len;
+			arena->tail = 0;
+		}
+	}else if(arena->head - arena->tail < record_len){
+		arena->failed++;
+		return NULL;
+	}
+	record = ARENA_record(arena, arena->tail);
+	record->len = record_len;
+	record->state = ARENA_RECORD_FREE;
+	return ARENA_data(record);
+}
+
+// Queue the reservation, shrunk to the len bytes written
+void ARENA_commit(ARENA_t *arena, void *data, size_t len){
+	ARENA_record_t *record = ARENA_record_of(arena, data);
+	record->len = ARENA_RECORD_LEN(len);
+	record->state = ARENA_RECORD_LIVE;
+	arena->tail += record->len;
+	if(arena->tail >= arena->size){
+		arena->tail = 0;
+	}
+	arena->used += record->len;
+	arena->count++;
+	if(arena->used > arena->max_used){
+		arena->max_used = arena->used;
+	}
+}
+
+void ARENA_release(ARENA_t *arena, void *data){
+	ARENA_record_t *record = ARENA_record_of(arena, data);
+	if(record->state != ARENA_RECORD_LIVE){
+		return;
+	}
+	record->state = ARENA_RECORD_FREE;
+	arena->count--;
+	// Give back the released records at the head. Empty, head meets the
+	// tail where it is: a reservation there stays valid until committed
+	while(arena->used > 0){
+		record = ARENA_record(arena, arena->head);
+		if(record->state != ARENA_RECORD_FREE){
+			break;
+		}
+		arena->used -= record->len;
+		arena->head += record->len;
+		if(arena->head >= arena->size){
+			arena->head = 0;
+		}
+	}
+}
+
+// Oldest live record, NULL when empty
+void * ARENA_first(ARENA_t *arena){
+	ARENA_record_t *record;
+	uint16_t offset = arena->head;
+	uint16_t walked = 0;
+	while(walked < arena->used){
+		record = ARENA_record(arena, offset);
+		if(record->state == ARENA_RECORD_LIVE){
+			return ARENA_data(record);
+		}
+		walked += record->len;
+		offset = (offset + record->len) % arena->size;
+	}
+	return NULL;
+}
+
+// Live record queued after data, NULL at the tail
+void * ARENA_next(ARENA_t *arena, void *data){
+	ARENA_record_t *record = ARENA_record_of(arena, data);
+	uint16_t offset = ARENA_offset(arena, record);
+	uint16_t walked = (offset + arena->size - arena->head) % arena->size;
+	walked += record->len;
+	offset = (offset + record->len) % arena->size;
+	while(walked < arena->used){
+		record = ARENA_record(arena, offset);
+		if(record->state == ARENA_RECORD_LIVE){
+			return ARENA_data(record);
+		}
+		walked += record->len;
+		offset = (offset + record->len) % arena->size;
+	}
+	return NULL;
+}
+
+/**
+ * Out of order release, end padding, a release between reserve and
+ * commit and a full arena on a 64 byte buffer.
+ */
+bool ARENA_test(){
+	static uint32_t buf[64 / sizeof(uint32_t)];
+	ARENA_t arena;
+	uint8_t *a, *b, *c, *d, *e, *f;
+	bool ok = true;
+	ARENA_init(&arena, (uint8_t*)buf, sizeof(buf));
+	// Out of order: b released first, its space returns with a
+	a = ARENA_reserve(&arena, 12);
+	ARENA_commit(&arena, a, 12);
+	b = ARENA_reserve(&arena, 12);
+	ARENA_commit(&arena, b, 12);
+	c = ARENA_reserve(&arena, 12);
+	memset(c, 'c', 12);
+	ARENA_commit(&arena, c, 12);
+	ARENA_release(&arena, b);
+	ok &= arena.count == 2 && arena.used == 48;
+	ok &= ARENA_first(&arena) == a && ARENA_next(&arena, a) == c;
+	ARENA_release(&arena, a);
+	ok &= arena.head == 32 && arena.used == 16 && ARENA_first(&arena) == c;
+	// 16 bytes left at the end, d needs 24: padded, d at the start
+	d = ARENA_reserve(&arena, 20);
+	ok &= d == (uint8_t*)buf + 4;
+	ARENA_commit(&arena, d, 20);
+	ok &= arena.used == 56 && ARENA_next(&arena, c) == d;
+	ok &= ARENA_reserve(&arena, 8) == NULL && arena.failed == 1;
+	ARENA_release(&arena, c);
+	ok &= arena.head == 0 && arena.used == 24 && ARENA_first(&arena) == d;
+	// Release of the last record while e is reserved, as coalescing does
+	e = ARENA_reserve(&arena, 8);
+	memset(e, 'e', 8);
+	ARENA_release(&arena, d);
+	ARENA_commit(&arena, e, 8);
+	ok &= arena.count == 1 && arena.used == 12 && ARENA_first(&arena) == e;
+	f = ARENA_reserve(&arena, 8);
+	ok &= f == e + 12;
+	memset(f, 'f', 8);
+	ok &= e[0] == 'e' && e[7] == 'e';
+	utils_log_info("ARENA_test: %s\r\n", ok ? "ok" : "failed");
+	return ok;
+}
+
+static ARENA_record_t * ARENA_record(ARENA_t *arena, uint16_t offset){
+	return (ARENA_record_t*)&arena->buf[offset];
+}
+
+static ARENA_record_t * ARENA_record_of(ARENA_t *arena, void *data){
+	return (ARENA_record_t*)((uint8_t*)data - ARENA_HEADER_LEN);
+}
+
+static void * ARENA_data(ARENA_record_t *record){
+	return (uint8_t*)record + ARENA_HEADER_LEN;
+}
+
+static uint16_t ARENA_offset(ARENA_t *arena, ARENA_record_t *record){
+	return (uint8_t*)record - arena->buf;
+}
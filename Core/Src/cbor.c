@@ -0,0 +1,112 @@
+/*
+ * cbor.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+
+#include "string.h"
+#include "cbor.h"
+
+enum {
+	CBOR_MAJOR_UINT = 0,
+	CBOR_MAJOR_NEGATIVE = 1,
+	CBOR_MAJOR_BYTES = 2,
+	CBOR_MAJOR_TEXT = 3,
+	CBOR_MAJOR_ARRAY = 4,
+	CBOR_MAJOR_MAP = 5,
+	CBOR_MAJOR_SIMPLE = 7
+};
+
+#define CBOR_SIMPLE_FALSE		20
+#define CBOR_SIMPLE_TRUE		21
+
+static void CBOR_put_head(CBOR_writer_t *writer, uint8_t major, uint32_t value);
+static void CBOR_put_raw(CBOR_writer_t *writer, const uint8_t *data, size_t data_len);
+
+/**
+ * Items are appended as they come, nothing is allocated. Maps and arrays
+ * take their item count first, a map of n pairs is followed by 2n items.
+ * With buf NULL nothing is written, len tells whether size would do.
+ */
+void CBOR_init(CBOR_writer_t *writer, uint8_t *buf, size_t size){
+	writer->buf = buf;
+	writer->size = size;
+	writer->len = 0;
+	writer->overflow = false;
+}
+
+void CBOR_put_uint(CBOR_writer_t *writer, uint32_t value){
+	CBOR_put_head(writer, CBOR_MAJOR_UINT, value);
+}
+
+void CBOR_put_int(CBOR_writer_t *writer, int32_t value){
+	if(value < 0){
+		// -1 - n
+		CBOR_put_head(writer, CBOR_MAJOR_NEGATIVE, (uint32_t)(-(value + 1)));
+		return;
+	}
+	CBOR_put_head(writer, CBOR_MAJOR_UINT, value);
+}
+
+void CBOR_put_bool(CBOR_writer_t *writer, bool value){
+	CBOR_put_head(writer, CBOR_MAJOR_SIMPLE, value ? CBOR_SIMPLE_TRUE : CBOR_SIMPLE_FALSE);
+}
+
+void CBOR_put_text(CBOR_writer_t *writer, const char *text){
+	size_t len = strlen(text);
+	CBOR_put_head(writer, CBOR_MAJOR_TEXT, len);
+	CBOR_put_raw(writer, (const uint8_t*)text, len);
+}
+
+void CBOR_put_bytes(CBOR_writer_t *writer, const uint8_t *data, size_t data_len){
+	CBOR_put_head(writer, CBOR_MAJOR_BYTES, data_len);
+	CBOR_put_raw(writer, data, data_len);
+}
+
+void CBOR_begin_array(CBOR_writer_t *writer, size_t count){
+	CBOR_put_head(writer, CBOR_MAJOR_ARRAY, count);
+}
+
+void CBOR_begin_map(CBOR_writer_t *writer, size_t count){
+	CBOR_put_head(writer, CBOR_MAJOR_MAP, count);
+}
+
+// Shortest form: values below 24 live in the initial byte, else 1, 2 or 4 bytes big endian follow
+static void CBOR_put_head(CBOR_writer_t *writer, uint8_t major, uint32_t value){
+	uint8_t head[5];
+	size_t len;
+	if(value < 24){
+		head[0] = (major << 5) | value;
+		len = 1;
+	}else if(value <= 0xFF){
+		head[0] = (major << 5) | 24;
+		head[1] = value;
+		len = 2;
+	}else if(value <= 0xFFFF){
+		head[0] = (major << 5) | 25;
+		head[1] = value >> 8;
+		head[2] = value;
+		len = 3;
+	}else{
+		head[0] = (major << 5) | 26;
+		head[1] = value >> 24;
+		head[2] = value >> 16;
+		head[3] = value >> 8;
+		head[4] = value;
+		len = 5;
+	}
+	CBOR_put_raw(writer, head, len);
+}
+
+static void CBOR_put_raw(CBOR_writer_t *writer, const uint8_t *data, size_t data_len){
+	if(writer->overflow || writer->len + data_len > writer->size){
+		writer->overflow = true;
+		return;
+	}
+	if(writer->buf != NULL){
+		memcpy(&writer->buf[writer->len], data, data_len);
+	}
+	writer->len += data_len;
+}
@@ -6,11 +6,52 @@
  */
 
 
+#include "stddef.h"
+#include "string.h"
 #include "config.h"
 #include "Device/eeprom.h"
+#include "Device/rtc.h"
+#include "Lib/scheduler/scheduler.h"
 #include "Lib/utils/utils_logger.h"
 
-#define EEPROM_CONFIG_ADDRESS	0x0000
+#define EEPROM_CONFIG_ADDRESS			0x0000	// Legacy layout, only read for migration
+#define EEPROM_CONFIG_SLOT_0_ADDRESS	0x0040
+#define EEPROM_CONFIG_SLOT_1_ADDRESS	0x0080
+#define EEPROM_CONFIG_SLOT_SIZE			0x0040	// 2 pages
+#define CONFIG_RECORD_MAGIC				0xC0F1
+#define NVRAM_CONFIG_SLOT_0_OFFSET		0
+#define NVRAM_CONFIG_SLOT_1_OFFSET		28
+#define CONFIG_HOT_RECORD_MAGIC			0xC0F2
+#define CONFIG_MIRROR_INTERVAL			600000	// 10 minutes
+
+/**
+ * Config is persisted as a record in one of two slots (A/B).
+ * A commit always writes the slot which is not holding the newest record,
+ * so a reset in the middle of the page writes leaves a bad checksum and
+ * the previous record is still loaded at boot.
+ */
+typedef struct {
+	uint16_t magic;
+	uint16_t checksum;
+	uint32_t sequence;
+	CONFIG_t config;
+}CONFIG_record_t;
+
+/**
+ * Amount and sale counters change on every sale, they are kept in DS1307
+ * NVRAM (A/B slots, 28 bytes each) and only mirrored to EEPROM every
+ * CONFIG_MIRROR_INTERVAL. At boot the copy with the newer sequence wins.
+ */
+typedef struct {
+	uint16_t magic;
+	uint16_t checksum;
+	uint32_t sequence;
+	uint32_t amount;
+	uint32_t total_amount;
+	uint32_t total_card;
+	uint32_t total_card_by_day;
+	uint32_t total_card_by_month;
+}CONFIG_hot_record_t;
 
 static CONFIG_t config = {
 	.version = VERSION,
@@ -24,15 +65,71 @@ static CONFIG_t config = {
 	.total_card_by_month = 0
 };
 
+static const uint16_t slot_address[] = {
+	EEPROM_CONFIG_SLOT_0_ADDRESS,
+	EEPROM_CONFIG_SLOT_1_ADDRESS
+};
+
+static const uint8_t hot_slot_offset[] = {
+	NVRAM_CONFIG_SLOT_0_OFFSET,
+	NVRAM_CONFIG_SLOT_1_OFFSET
+};
+
+// Record
+static uint32_t sequence = 0;
+static uint8_t active_slot = 1;		// Next commit goes to slot 0 on a blank EEPROM
+static uint8_t active_hot_slot = 1;
+static CONFIG_t persisted;			// Last config written to EEPROM
+static bool eeprom_dirty = false;
+
+// Transaction
+static bool in_transaction = false;
+static bool transaction_dirty = false;
+static CONFIG_t transaction_snapshot;
+
 static bool CONFIG_set_default(CONFIG_t * config,  CONFIG_t *config_temp);
 static bool CONFIG_field_is_empty(uint8_t *data, size_t data_len);
+static void CONFIG_load();
+static bool CONFIG_load_record(uint8_t slot, CONFIG_record_t *record);
+static bool CONFIG_load_hot_record(uint8_t slot, CONFIG_hot_record_t *record);
+static void CONFIG_load_hot();
+static void CONFIG_save();
+static void CONFIG_save_record();
+static bool CONFIG_save_hot_record();
+static bool CONFIG_is_hot_change();
+static uint16_t CONFIG_checksum(uint8_t *data, size_t data_len);
 
 bool CONFIG_init(){
-	CONFIG_t temp;
-	EEPROM_read(EEPROM_CONFIG_ADDRESS, (uint8_t*)&temp, sizeof(CONFIG_t));
-	CONFIG_set_default(&config, &temp);
-	utils_log_info("CONFIG init done\r\n");
+	CONFIG_load();
+	SCH_Add_Task(CONFIG_flush, CONFIG_MIRROR_INTERVAL, CONFIG_MIRROR_INTERVAL);
+	utils_log_info("CONFIG init done (seq %d)\r\n", sequence);
 	CONFIG_printf();
+	return true;
+}
+
+static void CONFIG_load(){
+	CONFIG_t temp;
+	CONFIG_record_t record[2];
+	bool valid[2];
+	for (uint8_t slot = 0; slot < 2; ++slot) {
+		valid[slot] = CONFIG_load_record(slot, &record[slot]);
+	}
+	if(valid[0] && valid[1]){
+		active_slot = ((int32_t)(record[1].sequence - record[0].sequence) > 0) ? 1 : 0;
+	}else if(valid[0] || valid[1]){
+		active_slot = valid[0] ? 0 : 1;
+	}else{
+		// No record yet -> Migrate from legacy layout
+		EEPROM_read(EEPROM_CONFIG_ADDRESS, (uint8_t*)&temp, sizeof(CONFIG_t));
+		CONFIG_set_default(&config, &temp);
+	}
+	if(valid[0] || valid[1]){
+		memcpy(&config, &record[active_slot].config, sizeof(CONFIG_t));
+		sequence = record[active_slot].sequence;
+	}
+	memcpy(&persisted, &config, sizeof(CONFIG_t));
+	eeprom_dirty = false;
+	CONFIG_load_hot();
 }
 
 CONFIG_t * CONFIG_get(){
@@ -40,11 +137,63 @@ CONFIG_t * CONFIG_get(){
 }
 
 void CONFIG_set(CONFIG_t * _config){
-	memcpy(&config, _config, sizeof(CONFIG_t));
-	EEPROM_write(EEPROM_CONFIG_ADDRESS, (uint8_t*)&config, sizeof(CONFIG_t));
+	if(_config != &config){
+		memcpy(&config, _config, sizeof(CONFIG_t));
+	}
+	if(in_transaction){
+		// Deferred to CONFIG_transaction_commit
+		transaction_dirty = true;
+		return;
+	}
+	CONFIG_save();
 	CONFIG_printf();
 }
 
+CONFIG_t * CONFIG_transaction_begin(){
+	if(!in_transaction){
+		memcpy(&transaction_snapshot, &config, sizeof(CONFIG_t));
+		in_transaction = true;
+		transaction_dirty = false;
+	}
+	return &config;
+}
+
+void CONFIG_transaction_commit(){
+	if(!in_transaction){
+		return;
+	}
+	in_transaction = false;
+	// Persist even without CONFIG_set call because caller may mutate through CONFIG_get
+	if(transaction_dirty || memcmp(&transaction_snapshot, &config, sizeof(CONFIG_t)) != 0){
+		CONFIG_save();
+		CONFIG_printf();
+	}
+	transaction_dirty = false;
+}
+
+void CONFIG_transaction_abort(){
+	if(!in_transaction){
+		return;
+	}
+	memcpy(&config, &transaction_snapshot, sizeof(CONFIG_t));
+	in_transaction = false;
+	transaction_dirty = false;
+}
+
+/**
+ * Mirror counters kept in NVRAM to EEPROM
+ */
+void CONFIG_flush(){
+	if(!eeprom_dirty || in_transaction){
+		return;
+	}
+	sequence++;
+	CONFIG_save_record();
+}
+
+bool CONFIG_is_in_transaction(){
+	return in_transaction;
+}
 
 void CONFIG_printf(){
 	utils_log_info("Version: %s\r\n", config.version);
@@ -59,8 +208,18 @@ void CONFIG_printf(){
 }
 
 void CONFIG_clear(){
+	uint8_t erased[EEPROM_CONFIG_SLOT_SIZE];
+	memset(erased, 0xFF, sizeof(erased));
 	memset(&config, 0xFF , sizeof(CONFIG_t));
-	EEPROM_write(EEPROM_CONFIG_ADDRESS, &config, sizeof(CONFIG_t));
+	EEPROM_write(EEPROM_CONFIG_ADDRESS, (uint8_t*)&config, sizeof(CONFIG_t));
+	EEPROM_write(EEPROM_CONFIG_SLOT_0_ADDRESS, erased, sizeof(erased));
+	EEPROM_write(EEPROM_CONFIG_SLOT_1_ADDRESS, erased, sizeof(erased));
+	RTC_write_nvram(NVRAM_CONFIG_SLOT_0_OFFSET, erased, sizeof(CONFIG_hot_record_t));
+	RTC_write_nvram(NVRAM_CONFIG_SLOT_1_OFFSET, erased, sizeof(CONFIG_hot_record_t));
+	sequence = 0;
+	active_slot = 1;
+	active_hot_slot = 1;
+	eeprom_dirty = false;
 }
 
 void CONFIG_test(){
@@ -70,6 +229,117 @@ void CONFIG_test(){
 	CONFIG_set(newConfig);
 }
 
+static bool CONFIG_load_record(uint8_t slot, CONFIG_record_t *record){
+	EEPROM_read(slot_address[slot], (uint8_t*)record, sizeof(CONFIG_record_t));
+	if(record->magic != CONFIG_RECORD_MAGIC){
+		return false;
+	}
+	return record->checksum == CONFIG_checksum((uint8_t*)&record->sequence,
+											sizeof(CONFIG_record_t) - offsetof(CONFIG_record_t, sequence));
+}
+
+static bool CONFIG_load_hot_record(uint8_t slot, CONFIG_hot_record_t *record){
+	if(!RTC_read_nvram(hot_slot_offset[slot], (uint8_t*)record, sizeof(CONFIG_hot_record_t))){
+		return false;
+	}
+	if(record->magic != CONFIG_HOT_RECORD_MAGIC){
+		return false;
+	}
+	return record->checksum == CONFIG_checksum((uint8_t*)&record->sequence,
+											sizeof(CONFIG_hot_record_t) - offsetof(CONFIG_hot_record_t, sequence));
+}
+
+static void CONFIG_load_hot(){
+	CONFIG_hot_record_t record[2];
+	bool valid[2];
+	for (uint8_t slot = 0; slot < 2; ++slot) {
+		valid[slot] = CONFIG_load_hot_record(slot, &record[slot]);
+	}
+	if(!valid[0] && !valid[1]){
+		return;
+	}
+	if(valid[0] && valid[1]){
+		active_hot_slot = ((int32_t)(record[1].sequence - record[0].sequence) > 0) ? 1 : 0;
+	}else{
+		active_hot_slot = valid[0] ? 0 : 1;
+	}
+	CONFIG_hot_record_t *hot = &record[active_hot_slot];
+	// Only take NVRAM copy when it is newer than EEPROM
+	if((int32_t)(hot->sequence - sequence) <= 0){
+		return;
+	}
+	config.amount = hot->amount;
+	config.total_amount = hot->total_amount;
+	config.total_card = hot->total_card;
+	config.total_card_by_day = hot->total_card_by_day;
+	config.total_card_by_month = hot->total_card_by_month;
+	sequence = hot->sequence;
+	eeprom_dirty = true;
+	utils_log_info("CONFIG counters restored from NVRAM\r\n");
+}
+
+static void CONFIG_save(){
+	sequence++;
+	// Counter only change -> One short NVRAM write, EEPROM is mirrored later
+	if(CONFIG_is_hot_change() && CONFIG_save_hot_record()){
+		eeprom_dirty = true;
+		return;
+	}
+	CONFIG_save_record();
+}
+
+static void CONFIG_save_record(){
+	CONFIG_record_t record;
+	uint8_t slot = active_slot ^ 1;
+	record.magic = CONFIG_RECORD_MAGIC;
+	record.sequence = sequence;
+	memcpy(&record.config, &config, sizeof(CONFIG_t));
+	record.checksum = CONFIG_checksum((uint8_t*)&record.sequence,
+									sizeof(CONFIG_record_t) - offsetof(CONFIG_record_t, sequence));
+	EEPROM_write(slot_address[slot], (uint8_t*)&record, sizeof(CONFIG_record_t));
+	active_slot = slot;
+	memcpy(&persisted, &config, sizeof(CONFIG_t));
+	eeprom_dirty = false;
+}
+
+static bool CONFIG_save_hot_record(){
+	CONFIG_hot_record_t record = {
+		.magic = CONFIG_HOT_RECORD_MAGIC,
+		.sequence = sequence,
+		.amount = config.amount,
+		.total_amount = config.total_amount,
+		.total_card = config.total_card,
+		.total_card_by_day = config.total_card_by_day,
+		.total_card_by_month = config.total_card_by_month
+	};
+	uint8_t slot = active_hot_slot ^ 1;
+	record.checksum = CONFIG_checksum((uint8_t*)&record.sequence,
+									sizeof(CONFIG_hot_record_t) - offsetof(CONFIG_hot_record_t, sequence));
+	if(!RTC_write_nvram(hot_slot_offset[slot], (uint8_t*)&record, sizeof(CONFIG_hot_record_t))){
+		return false;
+	}
+	active_hot_slot = slot;
+	return true;
+}
+
+static bool CONFIG_is_hot_change(){
+	return memcmp(config.version, persisted.version, sizeof(config.version)) == 0
+			&& memcmp(config.device_id, persisted.device_id, sizeof(config.device_id)) == 0
+			&& memcmp(config.password, persisted.password, sizeof(config.password)) == 0
+			&& config.card_price == persisted.card_price;
+}
+
+// Fletcher-16
+static uint16_t CONFIG_checksum(uint8_t *data, size_t data_len){
+	uint16_t sum1 = 0;
+	uint16_t sum2 = 0;
+	for (size_t var = 0; var < data_len; ++var) {
+		sum1 = (sum1 + data[var]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return (sum2 << 8) | sum1;
+}
+
 static bool CONFIG_set_default(CONFIG_t * _config,  CONFIG_t *config_temp){
 	// Set version
 	if(!CONFIG_field_is_empty((uint8_t*)config_temp->version, sizeof(config_temp->version))){
@@ -0,0 +1,306 @@
+/*
+ * ledger.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+
+#include "string.h"
+#include "ledger.h"
+#include "config.h"
+#include "Device/eeprom.h"
+#include "Lib/utils/utils_logger.h"
+
+#define EEPROM_LEDGER_ADDRESS		0x0100	// 0x0100 - 0x08FF: 64 records
+#define LEDGER_SLOT_SIZE			EEPROM_PAGE_SIZE	// One record per page, a single page write
+#define SECONDS_PER_DAY				86400
+
+/**
+ * A record as written to EEPROM, 20 bytes at the start of its page. A
+ * reset in the middle of a write leaves part of it old, the checksum
+ * tells it from a real sale.
+ */
+typedef struct {
+	LEDGER_record_t record;
+	uint16_t checksum;
+	uint16_t reserved;
+}LEDGER_stored_t;
+
+typedef struct {
+	uint16_t day;				// Days since 01/01/2000
+	uint16_t first_sequence;
+	uint16_t count;
+}LEDGER_day_index_t;
+
+static uint16_t next_sequence = 0;
+static size_t record_count = 0;
+
+// In-RAM index by day, oldest at day_index_head
+static LEDGER_day_index_t day_index[LEDGER_INDEX_DAY_MAX];
+static size_t day_index_head = 0;
+static size_t day_index_len = 0;
+
+static const uint16_t days_before_month[] = {
+	0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+};
+
+static bool LEDGER_append(uint8_t type, uint8_t tcd_id, uint32_t value, uint32_t amount);
+static bool LEDGER_read_record(uint16_t sequence, LEDGER_stored_t *stored);
+static bool LEDGER_is_valid(LEDGER_stored_t *stored);
+static uint16_t LEDGER_checksum(LEDGER_stored_t *stored);
+static uint16_t LEDGER_address(uint16_t sequence);
+static void LEDGER_index_add(uint16_t day, uint16_t sequence);
+static void LEDGER_index_drop_oldest();
+static void LEDGER_reconcile(LEDGER_record_t *record);
+
+bool LEDGER_init(){
+	LEDGER_stored_t stored;
+	LEDGER_record_t *record = &stored.record;
+	uint16_t newest = 0;
+	bool found = false;
+	// Pass 1: find newest record
+	for (uint16_t slot = 0; slot < LEDGER_RECORD_MAX; ++slot) {
+		if(!LEDGER_read_record(slot, &stored) || !LEDGER_is_valid(&stored)){
+			continue;
+		}
+		if(!found || (int16_t)(record->sequence - newest) > 0){
+			newest = record->sequence;
+			found = true;
+		}
+	}
+	if(!found){
+		utils_log_info("LEDGER init done: empty\r\n");
+		return true;
+	}
+	// Pass 2: walk back from newest while records are contiguous
+	uint16_t oldest = newest;
+	for (size_t var = 1; var < LEDGER_RECORD_MAX; ++var) {
+		uint16_t sequence = newest - var;
+		if(!LEDGER_read_record(sequence, &stored)
+				|| !LEDGER_is_valid(&stored)
+				|| record->sequence != sequence){
+			break;
+		}
+		oldest = sequence;
+	}
+	next_sequence = newest + 1;
+	record_count = (uint16_t)(newest - oldest) + 1;
+	// Pass 3: build day index from oldest to newest
+	for (uint16_t sequence = oldest; sequence != next_sequence; ++sequence) {
+		LEDGER_read_record(sequence, &stored);
+		LEDGER_index_add(record->timestamp / SECONDS_PER_DAY, sequence);
+	}
+	utils_log_info("LEDGER init done: %d records, next %d\r\n", record_count, next_sequence);
+	LEDGER_read_record(newest, &stored);
+	LEDGER_reconcile(record);
+	return true;
+}
+
+bool LEDGER_append_bill(uint32_t bill_value, uint32_t amount){
+	return LEDGER_append(LEDGER_TYPE_BILL, LEDGER_TCD_NONE, bill_value, amount);
+}
+
+bool LEDGER_append_card(TCD_id_t id, uint32_t card_price, uint32_t amount){
+	return LEDGER_append(LEDGER_TYPE_CARD, id, card_price, amount);
+}
+
+/**
+ * Return sequence of the first record of the day containing 'from'
+ * (or the oldest record when that day is no longer indexed)
+ */
+uint16_t LEDGER_seek(uint32_t from){
+	uint16_t day = from / SECONDS_PER_DAY;
+	uint16_t oldest = next_sequence - record_count;
+	for (size_t var = 0; var < day_index_len; ++var) {
+		LEDGER_day_index_t *entry = &day_index[(day_index_head + var) % LEDGER_INDEX_DAY_MAX];
+		if(entry->day >= day){
+			// Records before the first indexed day are older days
+			return var == 0 ? oldest : entry->first_sequence;
+		}
+	}
+	return day_index_len > 0 ? next_sequence : oldest;
+}
+
+/**
+ * Read up to max_records records with from <= timestamp <= to, starting at cursor.
+ * Cursor is advanced past every record read, LEDGER_is_end tells when done.
+ */
+size_t LEDGER_read(uint16_t *cursor, uint32_t from, uint32_t to, LEDGER_record_t *records, size_t max_records){
+	LEDGER_stored_t stored;
+	size_t len = 0;
+	uint16_t oldest = next_sequence - record_count;
+	// Records older than cursor may have been overwritten meanwhile
+	if((int16_t)(*cursor - oldest) < 0){
+		*cursor = oldest;
+	}
+	while(len < max_records && !LEDGER_is_end(*cursor)){
+		if(!LEDGER_read_record(*cursor, &stored)){
+			break;
+		}
+		if(!LEDGER_is_valid(&stored) || stored.record.sequence != *cursor){
+			// Torn by a reset, never exported as a sale
+			(*cursor)++;
+			continue;
+		}
+		memcpy(&records[len], &stored.record, sizeof(LEDGER_record_t));
+		if(records[len].timestamp > to){
+			*cursor = next_sequence;
+			break;
+		}
+		(*cursor)++;
+		if(records[len].timestamp >= from){
+			len++;
+		}
+	}
+	return len;
+}
+
+bool LEDGER_is_end(uint16_t cursor){
+	return (int16_t)(cursor - next_sequence) >= 0;
+}
+
+size_t LEDGER_get_count(){
+	return record_count;
+}
+
+uint32_t LEDGER_timestamp(RTC_t *rtc){
+	uint32_t year = rtc->year >= 2000 ? rtc->year - 2000 : 0;
+	uint32_t month = (rtc->month >= 1 && rtc->month <= 12) ? rtc->month - 1 : 0;
+	uint32_t days = year * 365 + (year + 3) / 4;
+	days += days_before_month[month];
+	if(month > 1 && (year % 4) == 0){
+		days++;
+	}
+	days += rtc->date > 0 ? rtc->date - 1 : 0;
+	return ((days * 24 + rtc->hour) * 60 + rtc->minute) * 60 + rtc->second;
+}
+
+void LEDGER_test(){
+	LEDGER_record_t records[4];
+	uint16_t cursor = LEDGER_seek(0);
+	LEDGER_append_bill(10000, 10000);
+	LEDGER_append_card(TCD_1, 10000, 0);
+	size_t len = LEDGER_read(&cursor, 0, 0xFFFFFFFF, records, 4);
+	utils_log_debug("LEDGER_test: read %d records\r\n", len);
+}
+
+static bool LEDGER_append(uint8_t type, uint8_t tcd_id, uint32_t value, uint32_t amount){
+	RTC_t rtc = RTC_get_time();
+	LEDGER_stored_t stored = {
+		.record = {
+			.sequence = next_sequence,
+			.type = type,
+			.tcd_id = tcd_id,
+			.timestamp = LEDGER_timestamp(&rtc),
+			.value = value,
+			.amount = amount
+		}
+	};
+	LEDGER_record_t *record = &stored.record;
+	stored.checksum = LEDGER_checksum(&stored);
+	if(!EEPROM_write(LEDGER_address(record->sequence), (uint8_t*)&stored, sizeof(LEDGER_stored_t))){
+		utils_log_error("LEDGER append failed\r\n");
+		return false;
+	}
+	// Oldest record was overwritten when full, it is still there when the write failed
+	if(record_count >= LEDGER_RECORD_MAX){
+		LEDGER_index_drop_oldest();
+		record_count--;
+	}
+	LEDGER_index_add(record->timestamp / SECONDS_PER_DAY, record->sequence);
+	next_sequence++;
+	record_count++;
+	return true;
+}
+
+static bool LEDGER_read_record(uint16_t sequence, LEDGER_stored_t *stored){
+	return EEPROM_read(LEDGER_address(sequence), (uint8_t*)stored, sizeof(LEDGER_stored_t));
+}
+
+static bool LEDGER_is_valid(LEDGER_stored_t *stored){
+	return (stored->record.type == LEDGER_TYPE_BILL || stored->record.type == LEDGER_TYPE_CARD)
+			&& stored->checksum == LEDGER_checksum(stored);
+}
+
+static uint16_t LEDGER_address(uint16_t sequence){
+	return EEPROM_LEDGER_ADDRESS + (sequence % LEDGER_RECORD_MAX) * LEDGER_SLOT_SIZE;
+}
+
+// Fletcher-16 of the record, as the outbox does
+static uint16_t LEDGER_checksum(LEDGER_stored_t *stored){
+	uint8_t *data = (uint8_t*)&stored->record;
+	uint16_t sum1 = 0;
+	uint16_t sum2 = 0;
+	for (size_t var = 0; var < sizeof(LEDGER_record_t); ++var) {
+		sum1 = (sum1 + data[var]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return (sum2 << 8) | sum1;
+}
+
+/**
+ * A sale is appended before the config is written, a reset in between
+ * leaves the config one record behind: its amount is still the one
+ * before the newest record. Only sales change the amount.
+ */
+static void LEDGER_reconcile(LEDGER_record_t *record){
+	CONFIG_t *config = CONFIG_get();
+	uint32_t amount_before = record->type == LEDGER_TYPE_BILL
+								? record->amount - record->value
+								: record->amount + record->value;
+	if(config->amount == record->amount || config->amount != amount_before){
+		return;
+	}
+	config = CONFIG_transaction_begin();
+	config->amount = record->amount;
+	if(record->type == LEDGER_TYPE_BILL){
+		config->total_amount += record->value;
+	}else{
+		config->total_card++;
+		config->total_card_by_day++;
+		config->total_card_by_month++;
+	}
+	CONFIG_transaction_commit();
+	utils_log_info("LEDGER record %d applied to config\r\n", record->sequence);
+}
+
+static void LEDGER_index_add(uint16_t day, uint16_t sequence){
+	LEDGER_day_index_t *last;
+	if(day_index_len > 0){
+		last = &day_index[(day_index_head + day_index_len - 1) % LEDGER_INDEX_DAY_MAX];
+		// Same day, or clock moved backwards -> Keep in current entry
+		if(last->day >= day){
+			last->count++;
+			return;
+		}
+	}
+	if(day_index_len >= LEDGER_INDEX_DAY_MAX){
+		// Oldest day is dropped from index, records are still readable from oldest
+		day_index_head = (day_index_head + 1) % LEDGER_INDEX_DAY_MAX;
+		day_index_len--;
+	}
+	last = &day_index[(day_index_head + day_index_len) % LEDGER_INDEX_DAY_MAX];
+	last->day = day;
+	last->first_sequence = sequence;
+	last->count = 1;
+	day_index_len++;
+}
+
+static void LEDGER_index_drop_oldest(){
+	uint16_t oldest = next_sequence - record_count;
+	if(day_index_len == 0){
+		return;
+	}
+	LEDGER_day_index_t *first = &day_index[day_index_head];
+	if(first->first_sequence != oldest){
+		// Oldest record's day was already dropped from index
+		return;
+	}
+	first->first_sequence++;
+	first->count--;
+	if(first->count == 0){
+		day_index_head = (day_index_head + 1) % LEDGER_INDEX_DAY_MAX;
+		day_index_len--;
+	}
+}
@@ -39,6 +39,9 @@
 #include "App/schedulerport.h"
 #include "App/statusreporter.h"
 #include "App/statemachine.h"
+#include "ledger.h"
+#include "outbox.h"
+#include "arena.h"
 
 /* USER CODE END Includes */
 
@@ -90,6 +93,8 @@ int main(void)
 //  WATCHDOG_init();
   // Init
   CONFIG_init();
+  LEDGER_init();
+  OUTBOX_init();
   SCHEDULERPORT_init();
 
   // Device Init
@@ -119,6 +124,11 @@ int main(void)
 //  RTC_test();
 //  EEPROM_test();
 //  CONFIG_test();
+//  LCD_benchmark();
+//  MQTT_benchmark();
+//  STATUSREPORTER_benchmark();
+//  LEDGER_test();
+//  ARENA_test();
 //  JSMNG_test();
 //  CONFIG_clear();
 //  WATCHDOG_test();
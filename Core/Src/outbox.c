@@ -0,0 +1,224 @@
+/*
+ * outbox.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+
+#include "stddef.h"
+#include "string.h"
+#include "outbox.h"
+#include "Device/eeprom.h"
+#include "Lib/utils/utils_logger.h"
+
+#define EEPROM_OUTBOX_ADDRESS		0x0B00	// 0x0B00 - 0x0EFF: 16 records, after the ledger
+#define OUTBOX_STATE_PENDING		0xA5
+#define OUTBOX_STATE_SENT			0x00
+
+/**
+ * Event messages which could not go out, kept across resets. A record
+ * is written once, then only its state byte is cleared when the broker
+ * acknowledged it. At boot the pending records are found by sequence
+ * like the ledger does, a bad checksum is a record cut by a reset.
+ */
+typedef struct {
+	uint16_t sequence;
+	uint8_t state;				// Not covered by the checksum
+	uint8_t topic_len;
+	uint8_t payload_len;
+	uint8_t reserved;
+	uint16_t checksum;
+	char data[OUTBOX_DATA_MAX];	// Topic then payload, not terminated
+}OUTBOX_record_t;
+
+static uint16_t next_sequence = 0;
+static uint16_t oldest = 0;			// Oldest pending, next_sequence when empty
+static uint16_t send_cursor = 0;	// Next to hand out to OUTBOX_next
+static bool acked[OUTBOX_RECORD_MAX];
+static OUTBOX_stats_t stats;
+// The message handed out by OUTBOX_next, header then topic and payload
+static uint32_t message_buf[(sizeof(MQTT_message_t) + OUTBOX_DATA_MAX + 2 + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+
+static bool OUTBOX_read_record(uint16_t sequence, OUTBOX_record_t *record);
+static bool OUTBOX_is_valid(OUTBOX_record_t *record);
+static uint16_t OUTBOX_address(uint16_t sequence);
+static uint16_t OUTBOX_checksum(OUTBOX_record_t *record);
+
+bool OUTBOX_init(){
+	OUTBOX_record_t record;
+	uint16_t newest = 0;
+	bool found = false;
+	// Pass 1: find newest record, sent or not
+	for (uint16_t slot = 0; slot < OUTBOX_RECORD_MAX; ++slot) {
+		if(!OUTBOX_read_record(slot, &record) || !OUTBOX_is_valid(&record)){
+			continue;
+		}
+		if(!found || (int16_t)(record.sequence - newest) > 0){
+			newest = record.sequence;
+			found = true;
+		}
+	}
+	if(!found){
+		utils_log_info("OUTBOX init done: empty\r\n");
+		return true;
+	}
+	next_sequence = newest + 1;
+	oldest = next_sequence;
+	// Pass 2: walk back from newest while records are contiguous, oldest pending one wins
+	for (size_t var = 1; var <= OUTBOX_RECORD_MAX; ++var) {
+		uint16_t sequence = next_sequence - var;
+		if(!OUTBOX_read_record(sequence, &record)
+				|| !OUTBOX_is_valid(&record)
+				|| record.sequence != sequence){
+			break;
+		}
+		acked[sequence % OUTBOX_RECORD_MAX] = record.state != OUTBOX_STATE_PENDING;
+		if(record.state == OUTBOX_STATE_PENDING){
+			oldest = sequence;
+		}
+	}
+	send_cursor = oldest;
+	utils_log_info("OUTBOX init done: %d pending, next %d\r\n", OUTBOX_get_count(), next_sequence);
+	return true;
+}
+
+/**
+ * Store a message to publish later at QoS 1, the oldest one is
+ * overwritten when the outbox is full.
+ */
+bool OUTBOX_push(MQTT_message_t * message){
+	OUTBOX_record_t record;
+	size_t topic_len = strnlen(message->topic, TOPIC_MAX_LEN);
+	size_t payload_len = strnlen(message->payload, PAYLOAD_MAX_LEN);
+	if(topic_len + payload_len > OUTBOX_DATA_MAX){
+		stats.too_long++;
+		utils_log_warn("OUTBOX message too long\r\n");
+		return false;
+	}
+	if(OUTBOX_get_count() >= OUTBOX_RECORD_MAX){
+		stats.overwritten++;
+		if(send_cursor == oldest){
+			send_cursor++;
+		}
+		oldest++;
+	}
+	memset(&record, 0, sizeof(record));
+	record.sequence = next_sequence;
+	record.state = OUTBOX_STATE_PENDING;
+	record.topic_len = topic_len;
+	record.payload_len = payload_len;
+	memcpy(record.data, message->topic, topic_len);
+	memcpy(record.data + topic_len, message->payload, payload_len);
+	record.checksum = OUTBOX_checksum(&record);
+	if(!EEPROM_write(OUTBOX_address(record.sequence), (uint8_t*)&record, sizeof(OUTBOX_record_t))){
+		utils_log_error("OUTBOX push failed\r\n");
+		return false;
+	}
+	acked[record.sequence % OUTBOX_RECORD_MAX] = false;
+	next_sequence++;
+	stats.spilled++;
+	return true;
+}
+
+/**
+ * Next pending message not handed out yet, always QoS 1, valid until the
+ * next call. The record stays pending until OUTBOX_ack.
+ */
+MQTT_message_t * OUTBOX_next(uint16_t * sequence){
+	MQTT_message_t * message = (MQTT_message_t*)message_buf;
+	OUTBOX_record_t record;
+	while(send_cursor != next_sequence){
+		uint16_t cursor = send_cursor++;
+		if(acked[cursor % OUTBOX_RECORD_MAX]){
+			continue;
+		}
+		if(!OUTBOX_read_record(cursor, &record)){
+			send_cursor = cursor;
+			return NULL;
+		}
+		if(!OUTBOX_is_valid(&record) || record.sequence != cursor){
+			stats.corrupted++;
+			OUTBOX_ack(cursor);
+			continue;
+		}
+		memset(message_buf, 0, sizeof(message_buf));
+		memcpy(message->topic, record.data, record.topic_len);
+		message->payload = &message->topic[record.topic_len + 1];
+		memcpy(message->payload, record.data + record.topic_len, record.payload_len);
+		message->payload_size = record.payload_len + 1;
+		message->qos = 1;
+		message->retain = 0;
+		*sequence = cursor;
+		return message;
+	}
+	return NULL;
+}
+
+/**
+ * Release a message acknowledged by the broker, only the state byte is
+ * written. Acknowledgments out of order are held until the older
+ * records are released too.
+ */
+void OUTBOX_ack(uint16_t sequence){
+	uint8_t state = OUTBOX_STATE_SENT;
+	if((int16_t)(sequence - oldest) < 0 || (int16_t)(sequence - next_sequence) >= 0){
+		return;
+	}
+	if(acked[sequence % OUTBOX_RECORD_MAX]){
+		return;
+	}
+	EEPROM_write(OUTBOX_address(sequence) + offsetof(OUTBOX_record_t, state), &state, 1);
+	acked[sequence % OUTBOX_RECORD_MAX] = true;
+	stats.drained++;
+	while(oldest != next_sequence && acked[oldest % OUTBOX_RECORD_MAX]){
+		oldest++;
+	}
+	if((int16_t)(send_cursor - oldest) < 0){
+		send_cursor = oldest;
+	}
+}
+
+// Hand out every pending message again, e.g. after the connection was lost
+void OUTBOX_rewind(){
+	send_cursor = oldest;
+}
+
+// Backlog depth
+size_t OUTBOX_get_count(){
+	return (uint16_t)(next_sequence - oldest);
+}
+
+OUTBOX_stats_t * OUTBOX_get_stats(){
+	return &stats;
+}
+
+static bool OUTBOX_read_record(uint16_t sequence, OUTBOX_record_t *record){
+	return EEPROM_read(OUTBOX_address(sequence), (uint8_t*)record, sizeof(OUTBOX_record_t));
+}
+
+static bool OUTBOX_is_valid(OUTBOX_record_t *record){
+	return (record->state == OUTBOX_STATE_PENDING || record->state == OUTBOX_STATE_SENT)
+			&& record->topic_len + record->payload_len <= OUTBOX_DATA_MAX
+			&& record->checksum == OUTBOX_checksum(record);
+}
+
+static uint16_t OUTBOX_address(uint16_t sequence){
+	return EEPROM_OUTBOX_ADDRESS + (sequence % OUTBOX_RECORD_MAX) * sizeof(OUTBOX_record_t);
+}
+
+// Fletcher-16 of the record but the state byte and the checksum
+static uint16_t OUTBOX_checksum(OUTBOX_record_t *record){
+	OUTBOX_record_t copy;
+	uint8_t *data = (uint8_t*)&copy;
+	uint16_t sum1 = 0;
+	uint16_t sum2 = 0;
+	memcpy(&copy, record, sizeof(copy));
+	copy.state = 0;
+	copy.checksum = 0;
+	for (size_t var = 0; var < sizeof(copy); ++var) {
+		sum1 = (sum1 + data[var]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return (sum2 << 8) | sum1;
+}
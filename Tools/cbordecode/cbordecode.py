@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+cbordecode.py
+
+Decoder for the binary payloads of STATUSREPORTER_set_binary_payload():
+<id>/rp/status/cbor, <id>/rp/bill_accepted/cbor and <id>/rp/ledger/cbor
+carry base64 of a CBOR map with integer keys. Prints each message as the
+JSON the firmware sends on the plain topics, ledger records as objects
+with absolute timestamps.
+
+Usage (from the repository root):
+    mosquitto_sub -v -t '+/rp/+/cbor' | python3 Tools/cbordecode/cbordecode.py
+    python3 Tools/cbordecode/cbordecode.py --topic status oWB...
+
+Input lines are "<topic> <base64>" as printed by mosquitto_sub -v.
+The integer keys are read from the STATUSREPORTER_*KEY_* enums of
+statusreporter.c, keys unknown to this script print as their number.
+"""
+
+import argparse
+import base64
+import json
+import os
+import re
+import sys
+
+REPORTER_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               '..', '..', 'Core', 'Src', 'App', 'statusreporter.c')
+
+# Enum name suffix to the JSON key of the plain topic
+STATUS_NAMES = {
+    'VERSION': 'v',
+    'PASSWORD': 'pwd',
+    'CARD_PRICE': 'cp',
+    'AMOUNT': 'amt',
+    'TOTAL_AMOUNT': 'to_amt',
+    'TOTAL_CARD': 'to_ca',
+    'TOTAL_CARD_BY_DAY': 'to_ca_d',
+    'TOTAL_CARD_BY_MONTH': 'to_ca_m',
+    'TCD_1': 'tcd_1',
+    'TCD_2': 'tcd_2',
+    'BILL': 'bill',
+    'LCD': 'lcd',
+    'LCD_DRAWS': 'lcd_d',
+    'MQTT': 'mq',
+}
+BILL_NAMES = {
+    'VALUE': 'value',
+}
+LEDGER_NAMES = {
+    'FIRST_SEQUENCE': 'first_sequence',
+    'MORE': 'more',
+    'RECORDS': 'records',
+}
+LEDGER_RECORD = ('sequence', 'type', 'tcd_id', 'timestamp', 'value', 'amount')
+
+
+def load_keys(source, prefix, names):
+    """Key number to name, in the order of the enum starting at prefix."""
+    match = re.search(r'enum\s*\{\s*(%s\w+.*?)\};' % prefix, source, re.S)
+    if not match:
+        raise SystemExit('%s enum not found' % prefix)
+    body = re.sub(r'//[^\n]*', '', match.group(1))
+    keys = {}
+    for number, member in enumerate(m.strip() for m in body.split(',') if m.strip()):
+        suffix = member[len(prefix):]
+        if suffix != 'MAX':
+            keys[number] = names.get(suffix, suffix.lower())
+    return keys
+
+
+class Reader:
+    """Definite length CBOR (RFC 8949), what CBOR_writer_t produces."""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, n):
+        if self.pos + n > len(self.data):
+            raise ValueError('truncated at %d' % self.pos)
+        chunk = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return chunk
+
+    def head(self):
+        initial = self.take(1)[0]
+        major, info = initial >> 5, initial & 0x1F
+        if info < 24:
+            return major, info
+        if info in (24, 25, 26, 27):
+            size = 1 << (info - 24)
+            return major, int.from_bytes(self.take(size), 'big')
+        raise ValueError('indefinite length at %d' % (self.pos - 1))
+
+    def item(self):
+        major, value = self.head()
+        if major == 0:
+            return value
+        if major == 1:
+            return -1 - value
+        if major == 2:
+            return self.take(value).hex()
+        if major == 3:
+            return self.take(value).decode('utf-8', 'replace')
+        if major == 4:
+            return [self.item() for _ in range(value)]
+        if major == 5:
+            items = {}
+            for _ in range(value):
+                key = self.item()
+                items[key] = self.item()
+            return items
+        if major == 7:
+            if value in (20, 21):
+                return value == 21
+            if value == 22:
+                return None
+        raise ValueError('unsupported item %d/%d' % (major, value))
+
+
+def decode(payload):
+    data = base64.b64decode(payload.strip())
+    reader = Reader(data)
+    item = reader.item()
+    if reader.pos != len(data):
+        raise ValueError('%d trailing bytes' % (len(data) - reader.pos))
+    return item, len(data)
+
+
+def rename(item, keys):
+    return {keys.get(k, k): v for k, v in item.items()}
+
+
+def ledger_records(message):
+    records = []
+    timestamp = 0
+    for fields in message.get('records', []):
+        record = dict(zip(LEDGER_RECORD, fields))
+        timestamp += record['timestamp']
+        record['timestamp'] = timestamp
+        records.append(record)
+    message['records'] = records
+    return message
+
+
+def topic_kind(topic):
+    parts = topic.strip('/').split('/')
+    if parts and parts[-1] == 'cbor':
+        parts = parts[:-1]
+    return parts[-1] if parts else topic
+
+
+def read_lines(stream, topic):
+    # One at a time as they arrive, a live mosquitto_sub pipe never ends
+    for line in iter(stream.readline, ''):
+        fields = line.split()
+        if len(fields) == 2:
+            yield fields[0], fields[1]
+        elif len(fields) == 1:
+            yield topic, fields[0]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('payloads', nargs='*', help='base64 payloads, else "<topic> <base64>" lines from stdin')
+    parser.add_argument('--topic', help='status, bill_accepted or ledger for the payload arguments')
+    parser.add_argument('--source', default=REPORTER_SOURCE, help='statusreporter.c with the key enums')
+    args = parser.parse_args()
+
+    with open(args.source) as f:
+        source = f.read()
+    tables = {
+        'status': load_keys(source, 'STATUSREPORTER_KEY_', STATUS_NAMES),
+        'bill_accepted': load_keys(source, 'STATUSREPORTER_BILL_KEY_', BILL_NAMES),
+        'ledger': load_keys(source, 'STATUSREPORTER_LEDGER_KEY_', LEDGER_NAMES),
+    }
+
+    if args.payloads:
+        messages = [(args.topic or '', p) for p in args.payloads]
+    else:
+        messages = read_lines(sys.stdin, args.topic or '')
+
+    failed = 0
+    for topic, payload in messages:
+        kind = topic_kind(topic)
+        try:
+            item, size = decode(payload)
+        except ValueError as e:
+            print('%s: %s' % (topic or payload, e), file=sys.stderr, flush=True)
+            failed += 1
+            continue
+        if isinstance(item, dict) and kind in tables:
+            item = rename(item, tables[kind])
+            if kind == 'ledger':
+                item = ledger_records(item)
+        text = json.dumps(item, separators=(',', ':'))
+        print('%s %s  # %d B cbor, %d B json' % (topic, text, size, len(text)) if topic
+              else '%s  # %d B cbor, %d B json' % (text, size, len(text)), flush=True)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,285 @@
+/*
+ * eepromsim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+
+#include "stdio.h"
+#include "stdarg.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "main.h"
+#include "Hal/i2c.h"
+#include "Hal/timer.h"
+#include "Device/rtc.h"
+#include "eepromsim.h"
+
+#define EEPROMSIM_EEPROM_ADDRESS	0xA0
+#define EEPROMSIM_DS1307_ADDRESS	0xD0
+#define EEPROMSIM_BYTE_BITS			9		// 8 data bits and the ack
+#define EEPROMSIM_FRAME_BITS		2		// Start and stop
+
+static EEPROMSIM_nv_t * nv = NULL;
+static EEPROMSIM_stats_t stats;
+static bool powered = true;
+static uint64_t busy_until_us = 0;		// End of the EEPROM write cycle
+static uint8_t ds1307_pointer = 0;
+static int32_t cut_writes_left = -1;	// Writes before the power cut, -1 never
+static uint32_t rng_state = 1;
+static bool verbose = false;
+
+static bool EEPROMSIM_write(uint8_t address, uint16_t mem_address, uint8_t * data, size_t data_len);
+static bool EEPROMSIM_read(uint8_t address, uint16_t mem_address, uint8_t * data, size_t data_len);
+static bool EEPROMSIM_is_busy(uint8_t address);
+static bool EEPROMSIM_take_cut();
+static void EEPROMSIM_bus_time(size_t bytes);
+static uint32_t EEPROMSIM_random();
+static uint8_t EEPROMSIM_bcd(uint8_t num);
+
+/**
+ * The content of both devices lives in shared memory so that every
+ * boot of a run, a fork, starts from what the previous one left.
+ */
+void EEPROMSIM_init(){
+	nv = mmap(NULL, sizeof(EEPROMSIM_nv_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if(nv == MAP_FAILED){
+		perror("EEPROMSIM_init");
+		nv = NULL;
+		return;
+	}
+	EEPROMSIM_erase();
+}
+
+EEPROMSIM_nv_t * EEPROMSIM_get_nv(){
+	return nv;
+}
+
+// Blank devices: EEPROM erased, DS1307 NVRAM cleared, wear counts reset
+void EEPROMSIM_erase(){
+	memset(nv->eeprom, 0xFF, sizeof(nv->eeprom));
+	memset(nv->cell_writes, 0, sizeof(nv->cell_writes));
+	memset(nv->ds1307, 0, sizeof(nv->ds1307));
+}
+
+void EEPROMSIM_power_on(){
+	memset(&stats, 0, sizeof(stats));
+	powered = true;
+	busy_until_us = 0;
+	ds1307_pointer = 0;
+	cut_writes_left = -1;
+}
+
+void EEPROMSIM_set_time(RTC_t * rtc){
+	nv->ds1307[0] = EEPROMSIM_bcd(rtc->second);
+	nv->ds1307[1] = EEPROMSIM_bcd(rtc->minute);
+	nv->ds1307[2] = EEPROMSIM_bcd(rtc->hour);
+	nv->ds1307[3] = 1;
+	nv->ds1307[4] = EEPROMSIM_bcd(rtc->date);
+	nv->ds1307[5] = EEPROMSIM_bcd(rtc->month);
+	nv->ds1307[6] = EEPROMSIM_bcd(rtc->year - 2000);
+}
+
+/**
+ * Power cut during the write after the next 'writes' ones: an EEPROM
+ * page then holds a mix of old, new and undefined bytes, a DS1307 write
+ * stops after a random number of bytes. Every transfer fails afterwards.
+ */
+void EEPROMSIM_cut_after(int32_t writes, uint32_t seed){
+	cut_writes_left = writes;
+	rng_state = seed * 2654435761u + 1;
+}
+
+bool EEPROMSIM_is_cut(){
+	return !powered;
+}
+
+EEPROMSIM_stats_t * EEPROMSIM_get_stats(){
+	return &stats;
+}
+
+void EEPROMSIM_set_verbose(bool _verbose){
+	verbose = _verbose;
+}
+
+void EEPROMSIM_log(const char * fmt, ...){
+	va_list args;
+	if(!verbose){
+		return;
+	}
+	va_start(args, fmt);
+	vprintf(fmt, args);
+	va_end(args);
+}
+
+// Hal/i2c.h on the model
+bool I2C_mem_write(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_w, size_t w_len){
+	EEPROMSIM_bus_time(1 + (mem_size == I2C_MEMADD_SIZE_8BIT ? 1 : 2) + w_len);
+	return EEPROMSIM_write(address, mem_address, data_w, w_len);
+}
+
+bool I2C_mem_read(uint8_t address, uint16_t mem_address, uint16_t mem_size, uint8_t * data_r, size_t r_len){
+	// Dummy write of the address, repeated start, then the data
+	EEPROMSIM_bus_time(1 + (mem_size == I2C_MEMADD_SIZE_8BIT ? 1 : 2) + 1 + r_len);
+	return EEPROMSIM_read(address, mem_address, data_r, r_len);
+}
+
+bool I2C_write(uint8_t address, uint8_t * data_w, size_t w_len){
+	EEPROMSIM_bus_time(1 + w_len);
+	if(address != EEPROMSIM_DS1307_ADDRESS || w_len == 0){
+		return false;
+	}
+	// First byte sets the register pointer, the rest is written from there
+	if(w_len == 1){
+		if(!powered){
+			return false;
+		}
+		ds1307_pointer = data_w[0];
+		return true;
+	}
+	return EEPROMSIM_write(address, data_w[0], &data_w[1], w_len - 1);
+}
+
+bool I2C_read(uint8_t address, uint8_t * data_r, size_t r_len){
+	EEPROMSIM_bus_time(1 + r_len);
+	if(address != EEPROMSIM_DS1307_ADDRESS){
+		return false;
+	}
+	return EEPROMSIM_read(address, ds1307_pointer, data_r, r_len);
+}
+
+bool I2C_write_and_read(uint8_t address, uint8_t * data_w, size_t w_len, uint8_t * data_r, size_t r_len){
+	bool success = I2C_write(address, data_w, w_len);
+	success = I2C_read(address, data_r, r_len) && success;
+	return success;
+}
+
+// Ack polling: one address byte per trial, NACKed until the write cycle is over
+bool I2C_is_device_ready(uint8_t address, uint32_t trials){
+	for (uint32_t trial = 0; trial < trials; ++trial) {
+		EEPROMSIM_bus_time(1);
+		if(!powered){
+			return false;
+		}
+		if(!EEPROMSIM_is_busy(address)){
+			return true;
+		}
+		stats.ack_polls++;
+	}
+	return false;
+}
+
+// Hal/timer.h and HAL tick on the bus time
+uint32_t TIMER_get_tick_us(){
+	return (uint32_t)stats.now_us;
+}
+
+uint32_t HAL_GetTick(void){
+	return (uint32_t)(stats.now_us / 1000);
+}
+
+static bool EEPROMSIM_write(uint8_t address, uint16_t mem_address, uint8_t * data, size_t data_len){
+	bool cut;
+	uint16_t cell;
+	if(!powered){
+		return false;
+	}
+	if(EEPROMSIM_is_busy(address)){
+		stats.busy_naks++;
+		return false;
+	}
+	cut = EEPROMSIM_take_cut();
+	stats.writes++;
+	if(address == EEPROMSIM_EEPROM_ADDRESS){
+		// The address counter only rolls over within the page
+		uint16_t page = (mem_address % EEPROM_SIZE) & ~(EEPROM_PAGE_SIZE - 1);
+		if((mem_address % EEPROM_PAGE_SIZE) + data_len > EEPROM_PAGE_SIZE){
+			stats.page_wraps++;
+		}
+		for (size_t var = 0; var < data_len; ++var) {
+			cell = page | ((mem_address + var) % EEPROM_PAGE_SIZE);
+			nv->cell_writes[cell]++;
+			if(!cut){
+				nv->eeprom[cell] = data[var];
+				continue;
+			}
+			switch (EEPROMSIM_random() % 3) {
+				case 0:
+					break;
+				case 1:
+					nv->eeprom[cell] = data[var];
+					break;
+				default:
+					nv->eeprom[cell] = EEPROMSIM_random();
+					break;
+			}
+		}
+		stats.page_writes++;
+		busy_until_us = stats.now_us + EEPROMSIM_WRITE_CYCLE_US;
+	}else if(address == EEPROMSIM_DS1307_ADDRESS){
+		size_t written = cut ? EEPROMSIM_random() % (data_len + 1) : data_len;
+		for (size_t var = 0; var < written; ++var) {
+			nv->ds1307[(mem_address + var) % EEPROMSIM_DS1307_SIZE] = data[var];
+		}
+		ds1307_pointer = (mem_address + data_len) % EEPROMSIM_DS1307_SIZE;
+		stats.nvram_writes++;
+	}else{
+		return false;
+	}
+	if(cut){
+		powered = false;
+		return false;
+	}
+	return true;
+}
+
+static bool EEPROMSIM_read(uint8_t address, uint16_t mem_address, uint8_t * data, size_t data_len){
+	if(!powered){
+		return false;
+	}
+	if(EEPROMSIM_is_busy(address)){
+		stats.busy_naks++;
+		return false;
+	}
+	for (size_t var = 0; var < data_len; ++var) {
+		if(address == EEPROMSIM_EEPROM_ADDRESS){
+			data[var] = nv->eeprom[(mem_address + var) % EEPROM_SIZE];
+		}else if(address == EEPROMSIM_DS1307_ADDRESS){
+			data[var] = nv->ds1307[(mem_address + var) % EEPROMSIM_DS1307_SIZE];
+		}else{
+			return false;
+		}
+	}
+	if(address == EEPROMSIM_DS1307_ADDRESS){
+		ds1307_pointer = (mem_address + data_len) % EEPROMSIM_DS1307_SIZE;
+	}
+	return true;
+}
+
+static bool EEPROMSIM_is_busy(uint8_t address){
+	return address == EEPROMSIM_EEPROM_ADDRESS && stats.now_us < busy_until_us;
+}
+
+static bool EEPROMSIM_take_cut(){
+	if(cut_writes_left < 0){
+		return false;
+	}
+	return cut_writes_left-- == 0;
+}
+
+static void EEPROMSIM_bus_time(size_t bytes){
+	stats.now_us += (bytes * EEPROMSIM_BYTE_BITS + EEPROMSIM_FRAME_BITS) * EEPROMSIM_BIT_US;
+}
+
+// xorshift32, runs are reproducible from the seed
+static uint32_t EEPROMSIM_random(){
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= rng_state << 5;
+	return rng_state;
+}
+
+static uint8_t EEPROMSIM_bcd(uint8_t num){
+	return ((num / 10) << 4) | (num % 10);
+}
@@ -0,0 +1,53 @@
+/*
+ * eepromsim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host model of the I2C1 bus of the board: a 24C32 EEPROM and the
+ * DS1307 time registers and NVRAM, behind the Hal/i2c.h API so that
+ * eeprom.c, rtc.c, config.c and ledger.c run unchanged on top of it.
+ */
+
+#ifndef EEPROMSIM_H_
+#define EEPROMSIM_H_
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdbool.h"
+#include "Device/eeprom.h"
+#include "Device/rtc.h"
+
+#define EEPROMSIM_BIT_US			10		// 100kHz bus
+#define EEPROMSIM_WRITE_CYCLE_US	5000	// tWR max of the 24C32, device NACKs meanwhile
+#define EEPROMSIM_DS1307_SIZE		64		// 8 time registers then 56 bytes NVRAM
+
+// Survives a reset: shared by every boot of a run (fork), see EEPROMSIM_init
+typedef struct {
+	uint8_t eeprom[EEPROM_SIZE];
+	uint32_t cell_writes[EEPROM_SIZE];		// Program cycles per byte
+	uint8_t ds1307[EEPROMSIM_DS1307_SIZE];
+}EEPROMSIM_nv_t;
+
+// One boot
+typedef struct {
+	uint64_t now_us;			// Bus time since power on
+	uint32_t writes;			// EEPROM page writes and DS1307 data writes
+	uint32_t page_writes;
+	uint32_t nvram_writes;
+	uint32_t ack_polls;			// Address probes NACKed during a write cycle
+	uint32_t busy_naks;			// Transfers sent during a write cycle: driver bug
+	uint32_t page_wraps;		// Page writes rolling over the page end: driver bug
+}EEPROMSIM_stats_t;
+
+void EEPROMSIM_init();
+EEPROMSIM_nv_t * EEPROMSIM_get_nv();
+void EEPROMSIM_erase();
+void EEPROMSIM_power_on();
+void EEPROMSIM_set_time(RTC_t * rtc);
+void EEPROMSIM_cut_after(int32_t writes, uint32_t seed);
+bool EEPROMSIM_is_cut();
+EEPROMSIM_stats_t * EEPROMSIM_get_stats();
+void EEPROMSIM_set_verbose(bool verbose);
+
+#endif /* EEPROMSIM_H_ */
@@ -0,0 +1,21 @@
+/*
+ * utils_logger.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the utils submodule logger, silent unless
+ * EEPROMSIM_set_verbose() was called.
+ */
+
+#ifndef EEPROMSIM_UTILS_LOGGER_H_
+#define EEPROMSIM_UTILS_LOGGER_H_
+
+void EEPROMSIM_log(const char * fmt, ...);
+
+#define utils_log_debug(...)		EEPROMSIM_log(__VA_ARGS__)
+#define utils_log_info(...)			EEPROMSIM_log(__VA_ARGS__)
+#define utils_log_warn(...)			EEPROMSIM_log(__VA_ARGS__)
+#define utils_log_error(...)		EEPROMSIM_log(__VA_ARGS__)
+
+#endif /* EEPROMSIM_UTILS_LOGGER_H_ */
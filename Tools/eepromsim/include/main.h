@@ -0,0 +1,27 @@
+/*
+ * main.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the CubeMX main.h: only what the drivers and
+ * persistence modules built by eepromsim take from the HAL.
+ */
+
+#ifndef EEPROMSIM_MAIN_H_
+#define EEPROMSIM_MAIN_H_
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdbool.h"
+
+#define I2C_MEMADD_SIZE_8BIT		0x00000001U
+#define I2C_MEMADD_SIZE_16BIT		0x00000010U
+
+#ifndef __ALIGNED
+#define __ALIGNED(x)				__attribute__((aligned(x)))
+#endif
+
+uint32_t HAL_GetTick(void);
+
+#endif /* EEPROMSIM_MAIN_H_ */
@@ -0,0 +1,362 @@
+/*
+ * replay.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Persistence cost and power cut safety of config.c and ledger.c, on
+ * the host model of the 24C32 and DS1307 (eepromsim.c):
+ * 1. A day of sales, a bill then a card each, with the 10 minute config
+ *    mirror: bus time, time blocked in the EEPROM driver, write cycles
+ *    of the most written EEPROM cell and the lifetime it gives.
+ * 2. For a bill, a card, a card price change and a mirror, the power is
+ *    cut at each of their writes with several tear patterns, then the
+ *    board boots: config and ledger must each be as before or as after,
+ *    never torn, and both on the same side.
+ *
+ * Usage (from the repository root):
+ *     make -C Tools/eepromsim
+ *     Tools/eepromsim/replay [sales per day] [-v]
+ *
+ * Every boot is a fork so config.c and ledger.c start from their
+ * initial statics like after a reset, only the devices keep content.
+ * Exit status is 1 when a cut leaves a torn state, config and ledger on
+ * different sides, or the driver misuses the device.
+ */
+
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/wait.h"
+#include "config.h"
+#include "ledger.h"
+#include "eepromsim.h"
+
+#define REPLAY_SALES_PER_DAY		300
+#define REPLAY_BILL_VALUE			10000
+#define REPLAY_MIRROR_MINUTES		10		// CONFIG_MIRROR_INTERVAL
+#define REPLAY_WARMUP_SALES			20		// Ledger and both config slots in use before the cuts
+#define REPLAY_TEAR_SEEDS			4		// Tear patterns per cut write
+#define MINUTES_PER_DAY				1440
+
+enum {
+	REPLAY_STEP_BILL,
+	REPLAY_STEP_CARD,
+	REPLAY_STEP_PRICE,
+	REPLAY_STEP_MIRROR,
+	REPLAY_STEP_MAX
+};
+
+// What a boot finds, written by the child into shared memory
+typedef struct {
+	CONFIG_t config;
+	LEDGER_record_t records[LEDGER_RECORD_MAX];
+	size_t records_len;
+	uint32_t writes;
+	EEPROMSIM_stats_t sim;
+	EEPROM_stats_t driver;
+}REPLAY_state_t;
+
+static const char * step_name[] = {
+	[REPLAY_STEP_BILL] = "bill",
+	[REPLAY_STEP_CARD] = "card",
+	[REPLAY_STEP_PRICE] = "card price",
+	[REPLAY_STEP_MIRROR] = "mirror",
+};
+
+static REPLAY_state_t * shared;
+static uint32_t sales_per_day = REPLAY_SALES_PER_DAY;
+
+static bool REPLAY_fork(void (*fn)(int32_t, int32_t), int32_t a, int32_t b);
+static void REPLAY_boot();
+static void REPLAY_capture(REPLAY_state_t * state);
+static void REPLAY_set_minute(uint32_t minute);
+static void REPLAY_step(int32_t step);
+static void REPLAY_day(int32_t unused_a, int32_t unused_b);
+static void REPLAY_warmup(int32_t unused_a, int32_t unused_b);
+static void REPLAY_look(int32_t unused_a, int32_t unused_b);
+static void REPLAY_reference(int32_t step, int32_t unused);
+static void REPLAY_cut(int32_t step, int32_t write_seed);
+static bool REPLAY_is_same_ledger(REPLAY_state_t * a, REPLAY_state_t * b);
+static bool REPLAY_report_day();
+static bool REPLAY_report_cuts();
+
+// Firmware dependency not under test: the mirror is driven by REPLAY_day
+uint32_t SCH_Add_Task(void (*p_function)(), uint32_t DELAY, uint32_t PERIOD){
+	return 1;
+}
+
+int main(int argc, char ** argv){
+	bool passed;
+	for (int var = 1; var < argc; ++var) {
+		if(strcmp(argv[var], "-v") == 0){
+			EEPROMSIM_set_verbose(true);
+		}else{
+			sales_per_day = atoi(argv[var]);
+		}
+	}
+	EEPROMSIM_init();
+	shared = mmap(NULL, sizeof(REPLAY_state_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if(EEPROMSIM_get_nv() == NULL || shared == MAP_FAILED){
+		return 2;
+	}
+	passed = REPLAY_report_day();
+	passed = REPLAY_report_cuts() && passed;
+	return passed ? 0 : 1;
+}
+
+static bool REPLAY_report_day(){
+	EEPROMSIM_nv_t * nv = EEPROMSIM_get_nv();
+	uint32_t max_writes = 0;
+	uint16_t max_cell = 0;
+	uint32_t sales = sales_per_day;
+	EEPROMSIM_erase();
+	if(!REPLAY_fork(REPLAY_day, 0, 0)){
+		return false;
+	}
+	for (uint16_t cell = 0; cell < EEPROM_SIZE; ++cell) {
+		if(nv->cell_writes[cell] > max_writes){
+			max_writes = nv->cell_writes[cell];
+			max_cell = cell;
+		}
+	}
+	printf("Day of %u sales (bill + card), config mirror every %d min\r\n", sales, REPLAY_MIRROR_MINUTES);
+	printf("  bus busy %u ms, EEPROM driver blocked %u ms (%u us per sale)\r\n",
+			(uint32_t)(shared->sim.now_us / 1000),
+			shared->driver.busy_us / 1000,
+			sales > 0 ? shared->driver.busy_us / sales : 0);
+	printf("  %u EEPROM page writes, %u NVRAM writes, %u ack polls, %u busy NACKs, %u page wraps\r\n",
+			shared->sim.page_writes,
+			shared->sim.nvram_writes,
+			shared->sim.ack_polls,
+			shared->sim.busy_naks,
+			shared->sim.page_wraps);
+	if(max_writes > 0){
+		printf("  most written cell 0x%04X: %u cycles/day, %u days (%u years) to %u cycles\r\n",
+				max_cell,
+				max_writes,
+				EEPROM_ENDURANCE / max_writes,
+				EEPROM_ENDURANCE / max_writes / 365,
+				EEPROM_ENDURANCE);
+	}
+	return shared->sim.busy_naks == 0 && shared->sim.page_wraps == 0;
+}
+
+static bool REPLAY_report_cuts(){
+	EEPROMSIM_nv_t * nv = EEPROMSIM_get_nv();
+	static EEPROMSIM_nv_t base;
+	static REPLAY_state_t before;
+	static REPLAY_state_t after;
+	uint32_t broken_total = 0;
+	uint32_t diverged_total = 0;
+	EEPROMSIM_erase();
+	REPLAY_fork(REPLAY_warmup, 0, 0);
+	memcpy(&base, nv, sizeof(base));
+	printf("Power cut at each write, %d tear patterns\r\n", REPLAY_TEAR_SEEDS);
+	for (int32_t step = 0; step < REPLAY_STEP_MAX; ++step) {
+		uint32_t consistent = 0;
+		uint32_t broken = 0;
+		uint32_t diverged = 0;
+		uint32_t writes;
+		// Before and after the step without a cut
+		memcpy(nv, &base, sizeof(base));
+		REPLAY_fork(REPLAY_look, 0, 0);
+		memcpy(&before, shared, sizeof(before));
+		REPLAY_fork(REPLAY_reference, step, 0);
+		writes = shared->writes;
+		REPLAY_fork(REPLAY_look, 0, 0);
+		memcpy(&after, shared, sizeof(after));
+		for (uint32_t write = 0; write < writes; ++write) {
+			for (uint32_t seed = 0; seed < REPLAY_TEAR_SEEDS; ++seed) {
+				memcpy(nv, &base, sizeof(base));
+				REPLAY_fork(REPLAY_cut, step, write * REPLAY_TEAR_SEEDS + seed);
+				REPLAY_fork(REPLAY_look, 0, 0);
+				bool config_before = memcmp(&shared->config, &before.config, sizeof(CONFIG_t)) == 0;
+				bool config_after = memcmp(&shared->config, &after.config, sizeof(CONFIG_t)) == 0;
+				bool ledger_before = REPLAY_is_same_ledger(shared, &before);
+				bool ledger_after = REPLAY_is_same_ledger(shared, &after);
+				if(!(config_before || config_after) || !(ledger_before || ledger_after)){
+					broken++;
+					printf("  %s, cut at write %u seed %u: config %s, ledger %s\r\n",
+							step_name[step],
+							write,
+							seed,
+							(config_before || config_after) ? "ok" : "torn",
+							(ledger_before || ledger_after) ? "ok" : "torn");
+				}else{
+					consistent++;
+					// Each store is atomic on its own, LEDGER_init must also bring them together
+					if(config_after != ledger_after && !(config_before && config_after)
+							&& !(ledger_before && ledger_after)){
+						diverged++;
+						printf("  %s, cut at write %u seed %u: config %s, ledger %s\r\n",
+								step_name[step],
+								write,
+								seed,
+								config_after ? "after" : "before",
+								ledger_after ? "after" : "before");
+					}
+				}
+			}
+		}
+		printf("  %-10s %u writes: %u consistent, %u torn, %u config and ledger on different sides\r\n",
+				step_name[step],
+				writes,
+				consistent,
+				broken,
+				diverged);
+		broken_total += broken;
+		diverged_total += diverged;
+	}
+	return broken_total == 0 && diverged_total == 0;
+}
+
+// Run fn in a child as one boot of the board, false when it crashed
+static bool REPLAY_fork(void (*fn)(int32_t, int32_t), int32_t a, int32_t b){
+	int status;
+	pid_t pid;
+	// Nothing buffered may be printed again by the child
+	fflush(stdout);
+	pid = fork();
+	if(pid == 0){
+		EEPROMSIM_power_on();
+		fn(a, b);
+		fflush(stdout);
+		_exit(0);
+	}
+	if(pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0){
+		printf("  boot %d failed\r\n", (int)pid);
+		return false;
+	}
+	return true;
+}
+
+static void REPLAY_boot(){
+	CONFIG_init();
+	LEDGER_init();
+}
+
+static void REPLAY_capture(REPLAY_state_t * state){
+	uint16_t cursor = LEDGER_seek(0);
+	memcpy(&state->config, CONFIG_get(), sizeof(CONFIG_t));
+	state->records_len = LEDGER_read(&cursor, 0, 0xFFFFFFFF, state->records, LEDGER_RECORD_MAX);
+	state->writes = EEPROMSIM_get_stats()->writes;
+	memcpy(&state->sim, EEPROMSIM_get_stats(), sizeof(EEPROMSIM_stats_t));
+	memcpy(&state->driver, EEPROM_get_stats(), sizeof(EEPROM_stats_t));
+}
+
+static void REPLAY_set_minute(uint32_t minute){
+	RTC_t rtc = {
+		.second = 0,
+		.minute = minute % 60,
+		.hour = minute / 60,
+		.date = 19,
+		.month = 10,
+		.year = 2026
+	};
+	EEPROMSIM_set_time(&rtc);
+}
+
+// The calls the firmware makes for each event
+static void REPLAY_step(int32_t step){
+	CONFIG_t * config;
+	uint32_t amount;
+	switch (step) {
+		case REPLAY_STEP_BILL:
+			// BILLACCEPTORMNG, bill stacked
+			config = CONFIG_get();
+			amount = config->amount + REPLAY_BILL_VALUE;
+			LEDGER_append_bill(REPLAY_BILL_VALUE, amount);
+			config->amount = amount;
+			config->total_amount += REPLAY_BILL_VALUE;
+			CONFIG_set(config);
+			break;
+		case REPLAY_STEP_CARD:
+			// SM_take_card_cb
+			config = CONFIG_get();
+			amount = config->amount - config->card_price;
+			LEDGER_append_card(TCD_1, config->card_price, amount);
+			config = CONFIG_transaction_begin();
+			config->total_card++;
+			config->total_card_by_day++;
+			config->total_card_by_month++;
+			config->amount = amount;
+			CONFIG_set(config);
+			CONFIG_transaction_commit();
+			break;
+		case REPLAY_STEP_PRICE:
+			// COMMANDHANDLER config
+			config = CONFIG_get();
+			config->card_price += 1000;
+			CONFIG_set(config);
+			break;
+		case REPLAY_STEP_MIRROR:
+			CONFIG_flush();
+			break;
+		default:
+			break;
+	}
+}
+
+static void REPLAY_day(int32_t unused_a, int32_t unused_b){
+	uint32_t next_mirror = REPLAY_MIRROR_MINUTES;
+	REPLAY_set_minute(0);
+	REPLAY_boot();
+	EEPROM_reset_stats();
+	memset(EEPROMSIM_get_stats(), 0, sizeof(EEPROMSIM_stats_t));
+	memset(EEPROMSIM_get_nv()->cell_writes, 0, sizeof(EEPROMSIM_get_nv()->cell_writes));
+	for (uint32_t sale = 0; sale < sales_per_day; ++sale) {
+		uint32_t minute = sale * MINUTES_PER_DAY / sales_per_day;
+		for (; next_mirror <= minute; next_mirror += REPLAY_MIRROR_MINUTES) {
+			CONFIG_flush();
+		}
+		REPLAY_set_minute(minute);
+		REPLAY_step(REPLAY_STEP_BILL);
+		REPLAY_step(REPLAY_STEP_CARD);
+	}
+	for (; next_mirror <= MINUTES_PER_DAY; next_mirror += REPLAY_MIRROR_MINUTES) {
+		CONFIG_flush();
+	}
+	REPLAY_capture(shared);
+}
+
+static void REPLAY_warmup(int32_t unused_a, int32_t unused_b){
+	REPLAY_set_minute(9 * 60);
+	REPLAY_boot();
+	for (uint32_t sale = 0; sale < REPLAY_WARMUP_SALES; ++sale) {
+		REPLAY_step(REPLAY_STEP_BILL);
+		REPLAY_step(REPLAY_STEP_CARD);
+		if(sale % 5 == 4){
+			REPLAY_step(REPLAY_STEP_MIRROR);
+		}
+	}
+	// Leave counters newer in NVRAM than in EEPROM, so the mirror has work
+	REPLAY_step(REPLAY_STEP_BILL);
+}
+
+static void REPLAY_look(int32_t unused_a, int32_t unused_b){
+	REPLAY_boot();
+	REPLAY_capture(shared);
+}
+
+static void REPLAY_reference(int32_t step, int32_t unused){
+	REPLAY_boot();
+	shared->writes = 0;
+	EEPROMSIM_get_stats()->writes = 0;
+	REPLAY_step(step);
+	shared->writes = EEPROMSIM_get_stats()->writes;
+}
+
+static void REPLAY_cut(int32_t step, int32_t write_seed){
+	REPLAY_boot();
+	EEPROMSIM_cut_after(write_seed / REPLAY_TEAR_SEEDS, write_seed);
+	REPLAY_step(step);
+}
+
+static bool REPLAY_is_same_ledger(REPLAY_state_t * a, REPLAY_state_t * b){
+	return a->records_len == b->records_len
+			&& memcmp(a->records, b->records, a->records_len * sizeof(LEDGER_record_t)) == 0;
+}
@@ -0,0 +1,21 @@
+/*
+ * utils_logger.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the utils submodule logger, silent unless
+ * lcdemu runs with -v.
+ */
+
+#ifndef LCDEMU_UTILS_LOGGER_H_
+#define LCDEMU_UTILS_LOGGER_H_
+
+void LCDEMU_log(const char * fmt, ...);
+
+#define utils_log_debug(...)		LCDEMU_log(__VA_ARGS__)
+#define utils_log_info(...)			LCDEMU_log(__VA_ARGS__)
+#define utils_log_warn(...)			LCDEMU_log(__VA_ARGS__)
+#define utils_log_error(...)		LCDEMU_log(__VA_ARGS__)
+
+#endif /* LCDEMU_UTILS_LOGGER_H_ */
@@ -0,0 +1,140 @@
+/*
+ * main.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the CubeMX main.h: the registers lcd.c and
+ * lcdmanager.c touch are plain structs, DWT->CYCCNT and HAL_GetTick()
+ * advance a simulated core clock on every read so the bus waits end.
+ */
+
+#ifndef LCDEMU_MAIN_H_
+#define LCDEMU_MAIN_H_
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdbool.h"
+
+#define LCDEMU_CORE_CLOCK			72000000
+
+typedef struct {
+	volatile uint32_t CRL;
+	volatile uint32_t CRH;
+	volatile uint32_t IDR;
+	volatile uint32_t ODR;
+	volatile uint32_t BSRR;
+	volatile uint32_t BRR;
+	volatile uint32_t LCKR;
+}GPIO_TypeDef;
+
+typedef struct {
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+}GPIO_InitTypeDef;
+
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+}DWT_Type;
+
+typedef struct {
+	volatile uint32_t DEMCR;
+}CoreDebug_Type;
+
+typedef struct {
+	volatile uint32_t CFGR;
+	volatile uint32_t AHBENR;
+	volatile uint32_t APB2ENR;
+}RCC_TypeDef;
+
+typedef struct {
+	volatile uint32_t CR1;
+	volatile uint32_t DIER;
+	volatile uint32_t SR;
+	volatile uint32_t EGR;
+	volatile uint32_t CCMR2;
+	volatile uint32_t CCER;
+	volatile uint32_t PSC;
+	volatile uint32_t ARR;
+	volatile uint32_t RCR;
+	volatile uint32_t CCR1;
+	volatile uint32_t CCR3;
+	volatile uint32_t BDTR;
+}TIM_TypeDef;
+
+typedef struct {
+	volatile uint32_t CCR;
+	volatile uint32_t CNDTR;
+	volatile uint32_t CPAR;
+	volatile uint32_t CMAR;
+}DMA_Channel_TypeDef;
+
+typedef struct {
+	volatile uint32_t ISR;
+	volatile uint32_t IFCR;
+}DMA_TypeDef;
+
+extern GPIO_TypeDef LCDEMU_gpiob;
+extern GPIO_TypeDef LCDEMU_gpiod;
+extern CoreDebug_Type LCDEMU_core_debug;
+extern RCC_TypeDef LCDEMU_rcc;
+extern TIM_TypeDef LCDEMU_tim1;
+extern DMA_Channel_TypeDef LCDEMU_dma1_channel2;
+extern DMA_TypeDef LCDEMU_dma1;
+extern uint32_t SystemCoreClock;
+
+DWT_Type * LCDEMU_dwt();
+
+#define GPIOB						(&LCDEMU_gpiob)
+#define GPIOD						(&LCDEMU_gpiod)
+#define DWT							LCDEMU_dwt()
+#define CoreDebug					(&LCDEMU_core_debug)
+#define RCC							(&LCDEMU_rcc)
+#define TIM1						(&LCDEMU_tim1)
+#define DMA1						(&LCDEMU_dma1)
+#define DMA1_Channel2				(&LCDEMU_dma1_channel2)
+
+#define GPIO_PIN_8					((uint16_t)0x0100)
+#define GPIO_PIN_9					((uint16_t)0x0200)
+#define GPIO_PIN_10					((uint16_t)0x0400)
+#define GPIO_PIN_11					((uint16_t)0x0800)
+#define GPIO_PIN_12					((uint16_t)0x1000)
+#define GPIO_PIN_13					((uint16_t)0x2000)
+#define GPIO_PIN_14					((uint16_t)0x4000)
+#define GPIO_PIN_15					((uint16_t)0x8000)
+#define GPIO_MODE_OUTPUT_PP			0x00000001U
+#define GPIO_PULLUP					0x00000001U
+#define GPIO_SPEED_FREQ_HIGH		0x00000003U
+
+#define CoreDebug_DEMCR_TRCENA_Msk	(1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk		(1UL << 0)
+#define RCC_CFGR_PPRE2				(7UL << 11)
+#define RCC_CFGR_PPRE2_DIV1			0x00000000U
+#define RCC_AHBENR_DMA1EN			(1UL << 0)
+#define RCC_APB2ENR_TIM1EN			(1UL << 11)
+#define TIM_CR1_CEN					(1UL << 0)
+#define TIM_CR1_OPM					(1UL << 3)
+#define TIM_DIER_CC1DE				(1UL << 9)
+#define TIM_EGR_UG					(1UL << 0)
+#define TIM_CCMR2_OC3M_0			(1UL << 4)
+#define TIM_CCMR2_OC3M_1			(1UL << 5)
+#define TIM_CCMR2_OC3M_2			(1UL << 6)
+#define TIM_CCER_CC3NE				(1UL << 10)
+#define TIM_BDTR_MOE				(1UL << 15)
+#define DMA_CCR_EN					(1UL << 0)
+#define DMA_CCR_DIR					(1UL << 4)
+#define DMA_CCR_MINC				(1UL << 7)
+#define DMA_CCR_PSIZE_1				(1UL << 9)
+#define DMA_CCR_MSIZE_1				(1UL << 11)
+#define DMA_IFCR_CGIF2				(1UL << 4)
+
+void HAL_GPIO_Init(GPIO_TypeDef * port, GPIO_InitTypeDef * init);
+void HAL_GPIO_WritePin(GPIO_TypeDef * port, uint16_t pin, uint32_t state);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+
+#endif /* LCDEMU_MAIN_H_ */
@@ -0,0 +1,229 @@
+/*
+ * lcdemu.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host build of lcd.c and lcdmanager.c on the ST7920 model: draws every
+ * LCDMNG screen with LCDMNG_draw_screens(), compares each frame with its
+ * golden image and reports the bus traffic per frame.
+ *
+ *   lcdemu [-v] [--golden DIR] [--out DIR] [--history FILE --label NAME]
+ *
+ * --out writes <frame>.pbm, --golden compares with <frame>.pbm (exit 1 on
+ * a pixel diff or a missing image), --history appends the bytes per frame
+ * to a CSV so they can be followed from build to build.
+ */
+
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdarg.h"
+#include "string.h"
+#include "time.h"
+#include "sys/stat.h"
+#include "main.h"
+#include "Device/lcd.h"
+#include "DeviceManager/lcdmanager.h"
+#include "st7920.h"
+
+#define LCDEMU_PATH_SIZE		256
+#define LCDEMU_SEED				1
+
+GPIO_TypeDef LCDEMU_gpiob;
+GPIO_TypeDef LCDEMU_gpiod;		// IDR stays 0: BF is never set, see ST7920_stats_t.bus_us
+CoreDebug_Type LCDEMU_core_debug;
+RCC_TypeDef LCDEMU_rcc;
+TIM_TypeDef LCDEMU_tim1;
+DMA_Channel_TypeDef LCDEMU_dma1_channel2;
+DMA_TypeDef LCDEMU_dma1;
+uint32_t SystemCoreClock = LCDEMU_CORE_CLOCK;
+
+static DWT_Type dwt;
+static uint64_t cycles = 0;
+static bool verbose = false;
+static const char * out_dir = NULL;
+static const char * golden_dir = NULL;
+static FILE * history = NULL;
+static const char * label = "unknown";
+static char stamp[32];
+static int failed = 0;
+
+static void LCDEMU_frame_done(const char * name);
+static bool LCDEMU_write_pbm(const char * path, const uint8_t * frame);
+static int LCDEMU_compare_pbm(const char * path, const uint8_t * frame);
+
+int main(int argc, char ** argv){
+	const char * history_path = NULL;
+	time_t now = time(NULL);
+	for (int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "-v") == 0){
+			verbose = true;
+		}else if(strcmp(argv[i], "--out") == 0 && i + 1 < argc){
+			out_dir = argv[++i];
+		}else if(strcmp(argv[i], "--golden") == 0 && i + 1 < argc){
+			golden_dir = argv[++i];
+		}else if(strcmp(argv[i], "--history") == 0 && i + 1 < argc){
+			history_path = argv[++i];
+		}else if(strcmp(argv[i], "--label") == 0 && i + 1 < argc){
+			label = argv[++i];
+		}else{
+			fprintf(stderr, "usage: %s [-v] [--golden DIR] [--out DIR] [--history FILE --label NAME]\n", argv[0]);
+			return 2;
+		}
+	}
+	if(out_dir != NULL){
+		mkdir(out_dir, 0777);
+	}
+	if(history_path != NULL){
+		struct stat st;
+		bool new_file = stat(history_path, &st) != 0;
+		history = fopen(history_path, "a");
+		if(history == NULL){
+			perror(history_path);
+			return 2;
+		}
+		if(new_file){
+			fprintf(history, "date,label,frame,commands,data,model_us\n");
+		}
+		strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+	}
+
+	ST7920_power_on(LCDEMU_SEED);
+	LCD_set_trace(ST7920_bus);
+	LCD_init();
+	LCDMNG_init();
+	// GDRAM clear queued by LCD_init, not part of the first frame
+	LCD_flush();
+	ST7920_reset_stats();
+	printf("%-16s %8s %8s %10s %10s %10s  %s\n", "frame", "commands", "data", "model us", "lcd bytes", "lcd text", "golden");
+	LCDMNG_draw_screens(LCDEMU_frame_done);
+	if(history != NULL){
+		fclose(history);
+	}
+	return failed ? 1 : 0;
+}
+
+void LCDEMU_log(const char * fmt, ...){
+	va_list args;
+	if(!verbose){
+		return;
+	}
+	va_start(args, fmt);
+	vprintf(fmt, args);
+	va_end(args);
+}
+
+// Every read is a cycle later, so the bus waits of lcd.c end
+DWT_Type * LCDEMU_dwt(){
+	dwt.CYCCNT = (uint32_t)cycles++;
+	return &dwt;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef * port, GPIO_InitTypeDef * init){
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef * port, uint16_t pin, uint32_t state){
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void){
+	return LCDEMU_CORE_CLOCK;
+}
+
+uint32_t HAL_GetTick(void){
+	cycles += LCDEMU_CORE_CLOCK / 1000000;
+	return (uint32_t)(cycles / (LCDEMU_CORE_CLOCK / 1000));
+}
+
+void HAL_Delay(uint32_t delay){
+	cycles += (uint64_t)delay * (LCDEMU_CORE_CLOCK / 1000);
+}
+
+static void LCDEMU_frame_done(const char * name){
+	uint8_t frame[LCD_FRAME_SIZE];
+	char path[LCDEMU_PATH_SIZE];
+	char result[32] = "-";
+	ST7920_stats_t *model = ST7920_get_stats();
+	LCD_stats_t *lcd = LCD_get_stats();
+	int diff;
+	ST7920_render(frame);
+	if(out_dir != NULL){
+		snprintf(path, sizeof(path), "%s/%s.pbm", out_dir, name);
+		if(!LCDEMU_write_pbm(path, frame)){
+			failed++;
+		}
+	}
+	if(golden_dir != NULL){
+		snprintf(path, sizeof(path), "%s/%s.pbm", golden_dir, name);
+		diff = LCDEMU_compare_pbm(path, frame);
+		if(diff < 0){
+			snprintf(result, sizeof(result), "missing");
+		}else if(diff > 0){
+			snprintf(result, sizeof(result), "%d pixels differ", diff);
+		}else{
+			snprintf(result, sizeof(result), "ok");
+		}
+		failed += diff != 0;
+	}
+	if(model->unknown_chars > 0){
+		snprintf(result + strlen(result), sizeof(result) - strlen(result), ", %d chars not in ROM", model->unknown_chars);
+	}
+	printf("%-16s %8d %8d %10d %10d %10d  %s\n",
+			name,
+			model->commands,
+			model->data,
+			model->bus_us,
+			lcd->last_frame_bytes + lcd->last_frame_commands,
+			lcd->text_bytes,
+			result);
+	if(history != NULL){
+		fprintf(history, "%s,%s,%s,%d,%d,%d\n", stamp, label, name, model->commands, model->data, model->bus_us);
+	}
+	ST7920_reset_stats();
+}
+
+// Plain PBM, one pixel row per line so a diff of two images reads as a picture
+static bool LCDEMU_write_pbm(const char * path, const uint8_t * frame){
+	FILE *f = fopen(path, "w");
+	if(f == NULL){
+		perror(path);
+		return false;
+	}
+	fprintf(f, "P1\n%d %d\n", LCD_WIDTH, LCD_HEIGHT);
+	for (uint8_t y = 0; y < LCD_HEIGHT; y++) {
+		for (uint8_t x = 0; x < LCD_WIDTH; x++) {
+			fputc((frame[y * LCD_ROW_BYTES + x / 8] >> (7 - x % 8)) & 1 ? '1' : '0', f);
+		}
+		fputc('\n', f);
+	}
+	fclose(f);
+	return true;
+}
+
+// Pixels differing from the image at path, -1 when it can not be read
+static int LCDEMU_compare_pbm(const char * path, const uint8_t * frame){
+	FILE *f = fopen(path, "r");
+	int width;
+	int height;
+	int c;
+	int diff = 0;
+	if(f == NULL){
+		return -1;
+	}
+	if(fscanf(f, "P1 %d %d", &width, &height) != 2 || width != LCD_WIDTH || height != LCD_HEIGHT){
+		fclose(f);
+		return -1;
+	}
+	for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+		do {
+			c = fgetc(f);
+		} while(c != EOF && c != '0' && c != '1');
+		if(c == EOF){
+			fclose(f);
+			return -1;
+		}
+		diff += (c - '0') != ((frame[i / 8] >> (7 - i % 8)) & 1);
+	}
+	fclose(f);
+	return diff;
+}
@@ -0,0 +1,36 @@
+/*
+ * st7920.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host model of the ST7920 on the 8 bit bus, fed with the bytes of
+ * LCD_send_command / LCD_send_data through LCD_set_trace(): basic and
+ * extended instruction sets, DDRAM text drawn from the half width
+ * character ROM and the 256x32 GDRAM, rendered to a 128x64 frame.
+ */
+
+#ifndef ST7920_H_
+#define ST7920_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "Device/lcd.h"
+
+#define ST7920_EXEC_US			72		// Every instruction and RAM write at 540kHz
+#define ST7920_CLEAR_US			1600	// Display clear
+
+typedef struct {
+	uint32_t commands;
+	uint32_t data;
+	uint32_t bus_us;			// Execution time of what was sent, the busy flag waits this long
+	uint32_t unknown_chars;		// DDRAM codes outside the modelled ROM, drawn blank
+}ST7920_stats_t;
+
+void ST7920_power_on(uint32_t seed);
+void ST7920_bus(bool rs, uint8_t data);
+void ST7920_render(uint8_t * frame);
+ST7920_stats_t * ST7920_get_stats();
+void ST7920_reset_stats();
+
+#endif /* ST7920_H_ */
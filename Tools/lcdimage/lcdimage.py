@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+lcdimage.py
+
+Convert monochrome artwork (PBM, or PNG when Pillow is installed) into
+PackBits compressed tables in the ST7920 native layout: rows of
+width / 8 bytes, MSB is the leftmost pixel, a set bit is a dark pixel.
+
+Usage (from the repository root):
+    python3 Tools/lcdimage/lcdimage.py Tools/lcdimage/images/*.pbm \\
+        --source Core/Src/DeviceManager/lcdimages.c \\
+        --header Core/Inc/DeviceManager/lcdimages.h
+
+Each image becomes a const LCDIMG_t named LCDIMG_<file name>.
+"""
+
+import argparse
+import os
+import sys
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    tokens = []
+    pos = 0
+    # Header: magic, width, height, comments allowed between tokens
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            while data[pos:pos + 1] not in (b'\n', b''):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b'P1':
+        bits = [int(c) for c in data[pos:].decode('ascii') if c in '01']
+        pixels = [bits[y * width:(y + 1) * width] for y in range(height)]
+    elif magic == b'P4':
+        pos += 1
+        row_bytes = (width + 7) // 8
+        pixels = []
+        for y in range(height):
+            row = data[pos + y * row_bytes:pos + (y + 1) * row_bytes]
+            pixels.append([(row[x // 8] >> (7 - x % 8)) & 1 for x in range(width)])
+    else:
+        raise ValueError('%s: only P1/P4 PBM is supported' % path)
+    return width, height, pixels
+
+
+def read_png(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise SystemExit('%s: PNG input needs Pillow (pip install pillow)' % path)
+    image = Image.open(path).convert('L')
+    width, height = image.size
+    pixels = [[1 if image.getpixel((x, y)) < 128 else 0 for x in range(width)]
+              for y in range(height)]
+    return width, height, pixels
+
+
+def to_native(width, pixels):
+    out = bytearray()
+    for row in pixels:
+        for x in range(0, width, 8):
+            byte = 0
+            for bit in range(8):
+                if x + bit < width and row[x + bit]:
+                    byte |= 0x80 >> bit
+            out.append(byte)
+    return bytes(out)
+
+
+def packbits(data):
+    """
+    Header n: 0..127 copy n + 1 literal bytes,
+    -127..-1 (0x81..0xFF) repeat the next byte 1 - n times.
+    """
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out.append((257 - run) & 0xFF)
+            out.append(data[i])
+            i += run
+            continue
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 1 < len(data) and data[i + 1] == data[i]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out.extend(data[start:i])
+    return bytes(out)
+
+
+def unpackbits(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        n = data[i]
+        i += 1
+        if n < 128:
+            out.extend(data[i:i + n + 1])
+            i += n + 1
+        elif n > 128:
+            out.extend(data[i:i + 1] * (257 - n))
+            i += 1
+    return bytes(out)
+
+
+def c_array(data, indent='\t'):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ','.join('0x%02X' % b for b in data[i:i + 16]) + ',')
+    if lines:
+        lines[-1] = lines[-1].rstrip(',')
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('images', nargs='+')
+    parser.add_argument('--source', required=True)
+    parser.add_argument('--header', required=True)
+    args = parser.parse_args()
+
+    header_name = os.path.basename(args.header)
+    guard = 'INC_DEVICEMANAGER_' + header_name.upper().replace('.', '_') + '_'
+    images = []
+    raw_total = 0
+    packed_total = 0
+    for path in sorted(args.images):
+        name = os.path.splitext(os.path.basename(path))[0]
+        if path.lower().endswith('.png'):
+            width, height, pixels = read_png(path)
+        else:
+            width, height, pixels = read_pbm(path)
+        if width % 8:
+            raise SystemExit('%s: width must be a multiple of 8' % path)
+        native = to_native(width, pixels)
+        packed = packbits(native)
+        assert unpackbits(packed, len(native)) == native
+        raw_total += len(native)
+        packed_total += len(packed)
+        images.append((name, width, height, packed, os.path.basename(path)))
+        print('%-12s %4d -> %4d bytes' % (name, len(native), len(packed)))
+    print('%-12s %4d -> %4d bytes' % ('total', raw_total, packed_total))
+
+    with open(args.header, 'w', newline='\n') as f:
+        f.write('/*\n * %s\n *\n * Generated by Tools/lcdimage/lcdimage.py, do not edit.\n */\n\n' % header_name)
+        f.write('#ifndef %s\n#define %s\n\n' % (guard, guard))
+        f.write('#include "stdio.h"\n\n')
+        f.write('typedef struct {\n')
+        f.write('\tuint8_t width;\n')
+        f.write('\tuint8_t height;\n')
+        f.write('\tuint16_t size;\t\t\t// Compressed bytes\n')
+        f.write('\tconst uint8_t *data;\t// PackBits of the native layout rows\n')
+        f.write('}LCDIMG_t;\n\n')
+        for name, _, _, _, _ in images:
+            f.write('extern const LCDIMG_t LCDIMG_%s;\n' % name)
+        f.write('\n#endif /* %s */\n' % guard)
+
+    with open(args.source, 'w', newline='\n') as f:
+        f.write('/*\n * %s\n *\n * Generated by Tools/lcdimage/lcdimage.py, do not edit.\n */\n\n'
+                % os.path.basename(args.source))
+        f.write('#include "DeviceManager/%s"\n' % header_name)
+        for name, width, height, packed, source in images:
+            f.write('\n// %s, %dx%d, %d bytes\n' % (source, width, height, len(packed)))
+            f.write('static const uint8_t %s_data[] = {\n%s\n};\n' % (name, c_array(packed)))
+            f.write('const LCDIMG_t LCDIMG_%s = {\n' % name)
+            f.write('\t\t.width = %d,\n\t\t.height = %d,\n\t\t.size = sizeof(%s_data),\n\t\t.data = %s_data\n};\n'
+                    % (width, height, name, name))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
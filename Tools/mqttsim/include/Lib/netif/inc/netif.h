@@ -0,0 +1,49 @@
+/*
+ * netif.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the netif submodule: only the calls mqtt.c makes,
+ * served by the ESP32 AT link model of netifsim.c.
+ */
+
+#ifndef MQTTSIM_NETIF_H_
+#define MQTTSIM_NETIF_H_
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdbool.h"
+
+typedef enum {
+	NETIF_OK,
+	NETIF_IN_PROCESS,
+	NETIF_FAIL
+}netif_status_t;
+
+typedef struct {
+	char * client_id;
+	char * host;
+	uint16_t port;
+	char * username;
+	char * password;
+	uint8_t reconnect;
+	uint16_t keep_alive;
+	void (*on_connect)(uint8_t status);
+	void (*on_disconnect)(uint8_t status);
+	void (*on_message)(char * topic, char * payload);
+	void (*on_publish)(uint8_t status);
+}netif_mqtt_client_t;
+
+uint32_t NETIF_GET_TIME_MS();
+
+void netif_init();
+void netif_run();
+netif_status_t netif_manager_is_connect_to_internet(bool * connected);
+netif_status_t netif_manager_reset();
+netif_status_t netif_mqtt_config(netif_mqtt_client_t * client);
+netif_status_t netif_mqtt_connect(netif_mqtt_client_t * client);
+netif_status_t netif_mqtt_subcribe(netif_mqtt_client_t * client, char * topic, uint8_t qos);
+netif_status_t netif_mqtt_publish(netif_mqtt_client_t * client, char * topic, char * payload, uint8_t qos, uint8_t retain);
+
+#endif /* MQTTSIM_NETIF_H_ */
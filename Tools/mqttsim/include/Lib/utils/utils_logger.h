@@ -0,0 +1,24 @@
+/*
+ * utils_logger.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the utils submodule logger. Debug is dropped, the
+ * rest is printed with -v or when it starts with the prefix given to
+ * NETIFSIM_show_log(), e.g. the MQTT_benchmark results.
+ */
+
+#ifndef MQTTSIM_UTILS_LOGGER_H_
+#define MQTTSIM_UTILS_LOGGER_H_
+
+#include "string.h"
+
+void NETIFSIM_log(const char * fmt, ...);
+
+#define utils_log_debug(...)
+#define utils_log_info(...)			NETIFSIM_log(__VA_ARGS__)
+#define utils_log_warn(...)			NETIFSIM_log(__VA_ARGS__)
+#define utils_log_error(...)		NETIFSIM_log(__VA_ARGS__)
+
+#endif /* MQTTSIM_UTILS_LOGGER_H_ */
@@ -0,0 +1,34 @@
+/*
+ * main.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host stand-in for the CubeMX main.h: only what statusreporter.c takes
+ * from the HAL. HAL_GetTick() is the simulated time of netifsim.c.
+ */
+
+#ifndef MQTTSIM_MAIN_H_
+#define MQTTSIM_MAIN_H_
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdbool.h"
+
+#ifndef __ALIGNED
+#define __ALIGNED(x)				__attribute__((aligned(x)))
+#endif
+
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+}DWT_Type;
+
+extern DWT_Type NETIFSIM_dwt;
+extern uint32_t SystemCoreClock;
+
+#define DWT							(&NETIFSIM_dwt)
+
+uint32_t HAL_GetTick(void);
+
+#endif /* MQTTSIM_MAIN_H_ */
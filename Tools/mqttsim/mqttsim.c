@@ -0,0 +1,352 @@
+/*
+ * mqttsim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Publish pipeline, outbox and status reports of mqtt.c, outbox.c and
+ * statusreporter.c on the host model of the ESP32 AT link (netifsim.c):
+ * 1. bench: MQTT_benchmark, msgs/s for every in flight setting with a
+ *    NETIFSIM_AT_MS command and NETIFSIM_ACK_MS to on_publish. --lose n
+ *    and --fail n drop or fail every nth completion.
+ * 2. outbox: bill_accepted events while connected with every second ack
+ *    lost, then during an outage. Each one must be acked by the broker
+ *    and the outbox must end empty.
+ * 3. status: status bytes of the first full report, of idle cycles and
+ *    of an amount change, then a TCD change whose report is lost and
+ *    which goes back: no critical report may fire after that.
+ *
+ * Usage (from the repository root):
+ *     make -C Tools/mqttsim
+ *     Tools/mqttsim/mqttsim [bench|outbox|status] [--lose n] [--fail n] [-v]
+ *
+ * Every scenario is a fork so mqtt.c and statusreporter.c start from
+ * their initial statics like after a reset. Exit status is 1 when the
+ * outbox or the status scenario fails its check.
+ */
+
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "unistd.h"
+#include "sys/wait.h"
+#include "main.h"
+#include "config.h"
+#include "ledger.h"
+#include "outbox.h"
+#include "App/mqtt.h"
+#include "App/statusreporter.h"
+#include "DeviceManager/billacceptormanager.h"
+#include "DeviceManager/tcdmanager.h"
+#include "DeviceManager/lcdmanager.h"
+#include "netifsim.h"
+
+#define SIM_BENCH_MS				1000000		// Every in flight setting, lost ones cost a timeout each
+#define SIM_READY_MS				60000
+#define SIM_TASK_MAX				4
+#define SIM_BILL_MAX				32
+#define SIM_BILL_BASE				10000
+#define SIM_OUTBOX_LOSE_EVERY		2
+#define SIM_OUTBOX_CONNECTED_BILLS	6
+#define SIM_OUTBOX_OUTAGE_BILLS		8			// Fits the outbox, none is overwritten
+#define SIM_OUTBOX_OUTAGE_MS		60000
+#define SIM_OUTBOX_DRAIN_MS			900000
+#define SIM_STATUS_CYCLE_MS			30000		// STATUSREPORT_INTERVAL
+#define SIM_STATUS_IDLE_CYCLES		2
+#define SIM_STATUS_QUIET_MS			60000		// Watched for critical reports after the TCD went back
+
+enum {
+	SIM_SCENARIO_BENCH,
+	SIM_SCENARIO_OUTBOX,
+	SIM_SCENARIO_STATUS,
+	SIM_SCENARIO_MAX
+};
+
+typedef struct {
+	void (*function)();
+	uint32_t at;
+}SIM_task_t;
+
+static const char * const scenario_names[SIM_SCENARIO_MAX] = {
+	[SIM_SCENARIO_BENCH] = "bench",
+	[SIM_SCENARIO_OUTBOX] = "outbox",
+	[SIM_SCENARIO_STATUS] = "status",
+};
+
+static NETIFSIM_link_t sim_link = {
+		.at_ms = NETIFSIM_AT_MS,
+		.ack_ms = NETIFSIM_ACK_MS,
+		.lose_every = 0,
+		.fail_every = 0
+};
+static CONFIG_t config = {
+		.version = "1.0.0",
+		.device_id = "kiosk1",
+		.password = "123456",
+		.card_price = 10000,
+		.amount = 0,
+		.total_amount = 250000,
+		.total_card = 25,
+		.total_card_by_day = 5,
+		.total_card_by_month = 25
+};
+static TCDMNG_Status_t tcd_status;
+static SIM_task_t tasks[SIM_TASK_MAX];
+static bool status_enable = false;
+
+// What went over the link, filled by SIM_observe
+static bool bill_acked[SIM_BILL_MAX];
+static uint32_t status_publishes;
+static uint32_t status_bytes;
+static char status_last[PAYLOAD_MAX_LEN];
+
+static bool SIM_fork(bool (*fn)());
+static void SIM_boot();
+static void SIM_run_until(uint32_t at);
+static bool SIM_run_until_ready();
+static void SIM_observe(uint8_t event, const char * topic, const char * payload);
+static bool SIM_bench();
+static bool SIM_outbox();
+static bool SIM_status();
+
+// Firmware dependencies not under test
+CONFIG_t * CONFIG_get(){
+	return &config;
+}
+
+TCDMNG_Status_t TCDMNG_get_status(){
+	return tcd_status;
+}
+
+uint8_t BILLACCEPTORMNG_get_status(){
+	return 0;
+}
+
+// The working screen redraws its clock every second, the counters keep growing
+void LCDMNG_get_metrics(LCDMNG_metrics_t *metrics){
+	memset(metrics, 0, sizeof(LCDMNG_metrics_t));
+	metrics->screens[LCDMNG_SCREEN_WORKING].draws = NETIFSIM_now() / 1000;
+	metrics->screens[LCDMNG_SCREEN_WORKING].bytes = NETIFSIM_now() / 1000 * 218;
+}
+
+uint16_t LEDGER_seek(uint32_t from){
+	return 0;
+}
+
+size_t LEDGER_read(uint16_t *cursor, uint32_t from, uint32_t to, LEDGER_record_t *records, size_t max_records){
+	return 0;
+}
+
+bool LEDGER_is_end(uint16_t cursor){
+	return true;
+}
+
+// One shot tasks, fired by SIM_run_until
+uint32_t SCH_Add_Task(void (*p_function)(), uint32_t DELAY, uint32_t PERIOD){
+	for (uint32_t id = 0; id < SIM_TASK_MAX; ++id) {
+		if(tasks[id].function == NULL){
+			tasks[id].function = p_function;
+			tasks[id].at = NETIFSIM_now() + DELAY;
+			return id;
+		}
+	}
+	return SIM_TASK_MAX;
+}
+
+int main(int argc, char ** argv){
+	bool (*scenarios[SIM_SCENARIO_MAX])() = {
+		[SIM_SCENARIO_BENCH] = SIM_bench,
+		[SIM_SCENARIO_OUTBOX] = SIM_outbox,
+		[SIM_SCENARIO_STATUS] = SIM_status,
+	};
+	int32_t only = -1;
+	bool passed = true;
+	for (int var = 1; var < argc; ++var) {
+		if(strcmp(argv[var], "-v") == 0){
+			NETIFSIM_set_verbose(true);
+		}else if(strcmp(argv[var], "--lose") == 0 && var + 1 < argc){
+			sim_link.lose_every = atoi(argv[++var]);
+		}else if(strcmp(argv[var], "--fail") == 0 && var + 1 < argc){
+			sim_link.fail_every = atoi(argv[++var]);
+		}else{
+			for (int32_t id = 0; id < SIM_SCENARIO_MAX; ++id) {
+				if(strcmp(argv[var], scenario_names[id]) == 0){
+					only = id;
+				}
+			}
+			if(only < 0){
+				printf("unknown argument %s\r\n", argv[var]);
+				return 2;
+			}
+		}
+	}
+	for (int32_t id = 0; id < SIM_SCENARIO_MAX; ++id) {
+		if(only < 0 || only == id){
+			printf("%s\r\n", scenario_names[id]);
+			passed = SIM_fork(scenarios[id]) && passed;
+		}
+	}
+	return passed ? 0 : 1;
+}
+
+static bool SIM_fork(bool (*fn)()){
+	int status;
+	pid_t pid;
+	// Nothing buffered may be printed again by the child
+	fflush(stdout);
+	pid = fork();
+	if(pid == 0){
+		status = fn() ? 0 : 1;
+		fflush(stdout);
+		_exit(status);
+	}
+	if(pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0){
+		printf("  FAILED\r\n");
+		return false;
+	}
+	return true;
+}
+
+static void SIM_boot(){
+	NETIFSIM_init(&sim_link);
+	NETIFSIM_set_observer(SIM_observe);
+	OUTBOX_init();
+	MQTT_init();
+}
+
+// The superloop, one pass per simulated ms
+static void SIM_run_until(uint32_t at){
+	void (*function)();
+	while(NETIFSIM_now() < at){
+		NETIFSIM_tick();
+		MQTT_run();
+		if(status_enable){
+			STATUSREPORTER_run();
+		}
+		for (uint32_t id = 0; id < SIM_TASK_MAX; ++id) {
+			if(tasks[id].function != NULL && tasks[id].at <= NETIFSIM_now()){
+				function = tasks[id].function;
+				tasks[id].function = NULL;
+				function();
+			}
+		}
+	}
+}
+
+static bool SIM_run_until_ready(){
+	while(!MQTT_is_ready() && NETIFSIM_now() < SIM_READY_MS){
+		SIM_run_until(NETIFSIM_now() + 1);
+	}
+	return MQTT_is_ready();
+}
+
+static void SIM_observe(uint8_t event, const char * topic, const char * payload){
+	unsigned int value;
+	if(strstr(topic, "/rp/bill_accepted") != NULL){
+		if(event == NETIFSIM_EVENT_ACK
+				&& sscanf(payload, "{\"value\":%u}", &value) == 1
+				&& value >= SIM_BILL_BASE && value < SIM_BILL_BASE + SIM_BILL_MAX){
+			bill_acked[value - SIM_BILL_BASE] = true;
+		}
+	}else if(strstr(topic, "/rp/status") != NULL && event == NETIFSIM_EVENT_PUBLISH){
+		status_publishes++;
+		status_bytes += strlen(payload);
+		snprintf(status_last, sizeof(status_last), "%s", payload);
+	}
+}
+
+static bool SIM_bench(){
+	MQTT_stats_t * stats;
+	NETIFSIM_show_log("MQTT_benchmark");
+	SIM_boot();
+	MQTT_benchmark();
+	SIM_run_until(SIM_BENCH_MS);
+	stats = MQTT_get_stats();
+	printf("  link: %d ms AT command, %d ms to on_publish, lose every %d, fail every %d\r\n",
+			sim_link.at_ms, sim_link.ack_ms, sim_link.lose_every, sim_link.fail_every);
+	printf("  published %d, acked %d, failed %d, ack timeouts %d\r\n",
+			stats->published, stats->acked, stats->failed, stats->ack_timeouts);
+	return stats->acked > 0;
+}
+
+static bool SIM_outbox(){
+	uint32_t bills = 0;
+	uint32_t acked = 0;
+	sim_link.lose_every = SIM_OUTBOX_LOSE_EVERY;
+	sim_link.fail_every = 0;
+	SIM_boot();
+	if(!SIM_run_until_ready()){
+		printf("  not connected\r\n");
+		return false;
+	}
+	for (uint32_t i = 0; i < SIM_OUTBOX_CONNECTED_BILLS; ++i) {
+		STATUSREPORTER_report_billaccepted(SIM_BILL_BASE + bills++);
+		SIM_run_until(NETIFSIM_now() + 5);
+	}
+	SIM_run_until(NETIFSIM_now() + 1000);
+	NETIFSIM_set_link_up(false);
+	for (uint32_t i = 0; i < SIM_OUTBOX_OUTAGE_BILLS; ++i) {
+		STATUSREPORTER_report_billaccepted(SIM_BILL_BASE + bills++);
+		SIM_run_until(NETIFSIM_now() + 5);
+	}
+	SIM_run_until(NETIFSIM_now() + SIM_OUTBOX_OUTAGE_MS);
+	NETIFSIM_set_link_up(true);
+	while(OUTBOX_get_count() > 0 && NETIFSIM_now() < SIM_OUTBOX_DRAIN_MS){
+		SIM_run_until(NETIFSIM_now() + 1000);
+	}
+	for (uint32_t i = 0; i < bills; ++i) {
+		acked += bill_acked[i];
+	}
+	printf("  %d bills (%d connected, %d in an outage), every %d ack lost: %d acked, %d left in the outbox, %d overwritten, %d s\r\n",
+			bills,
+			SIM_OUTBOX_CONNECTED_BILLS,
+			SIM_OUTBOX_OUTAGE_BILLS,
+			SIM_OUTBOX_LOSE_EVERY,
+			acked,
+			(int)OUTBOX_get_count(),
+			OUTBOX_get_stats()->overwritten,
+			NETIFSIM_now() / 1000);
+	return acked == bills && OUTBOX_get_count() == 0;
+}
+
+static bool SIM_status(){
+	STATUSREPORTER_stats_t * stats = STATUSREPORTER_get_stats();
+	uint32_t idle_publishes;
+	uint32_t critical;
+	bool delta_ok;
+	status_enable = true;
+	SIM_boot();
+	if(!SIM_run_until_ready()){
+		printf("  not connected\r\n");
+		return false;
+	}
+	// First report, every field
+	SIM_run_until(SIM_STATUS_CYCLE_MS - 1000);
+	printf("  full: %d B %s\r\n", status_bytes, status_last);
+	// Nothing changed but the telemetry counters
+	status_publishes = 0;
+	status_bytes = 0;
+	SIM_run_until(NETIFSIM_now() + SIM_STATUS_IDLE_CYCLES * SIM_STATUS_CYCLE_MS);
+	idle_publishes = status_publishes;
+	printf("  idle: %d cycles, %d reports, %d B\r\n", SIM_STATUS_IDLE_CYCLES, status_publishes, status_bytes);
+	// A sale moves the amount
+	status_publishes = 0;
+	status_bytes = 0;
+	config.amount += 20000;
+	SIM_run_until(NETIFSIM_now() + SIM_STATUS_CYCLE_MS);
+	delta_ok = status_publishes == 1 && strcmp(status_last, "{\"amt\":20000}") == 0;
+	printf("  amount change: %d reports, %d B %s\r\n", status_publishes, status_bytes, status_last);
+	// TCD empty, its critical report is lost, then it is refilled
+	tcd_status.TCD_1.is_empty = true;
+	NETIFSIM_lose_next(1);
+	SIM_run_until(NETIFSIM_now() + 1000);
+	tcd_status.TCD_1.is_empty = false;
+	SIM_run_until(NETIFSIM_now() + MQTT_PUBLISH_ACK_TIMEOUT + 5000);
+	critical = stats->critical;
+	SIM_run_until(NETIFSIM_now() + SIM_STATUS_QUIET_MS);
+	printf("  lost critical report, TCD back: %d critical reports in the %d s after its timeout\r\n",
+			stats->critical - critical,
+			SIM_STATUS_QUIET_MS / 1000);
+	return idle_publishes == 0 && delta_ok && stats->critical == critical;
+}
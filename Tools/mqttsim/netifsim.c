@@ -0,0 +1,234 @@
+/*
+ * netifsim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ */
+
+
+#include "stdio.h"
+#include "stdarg.h"
+#include "string.h"
+#include "main.h"
+#include "App/mqtt.h"
+#include "Device/eeprom.h"
+#include "Lib/netif/inc/netif.h"
+#include "netifsim.h"
+
+// A publish waiting for its on_publish
+typedef struct {
+	uint32_t at;
+	uint8_t status;
+	char topic[TOPIC_MAX_LEN];
+	char payload[PAYLOAD_MAX_LEN];
+}NETIFSIM_ack_t;
+
+DWT_Type NETIFSIM_dwt;
+uint32_t SystemCoreClock = 72000000;
+
+static NETIFSIM_link_t link;
+static NETIFSIM_stats_t stats;
+static NETIFSIM_observer_t observer = NULL;
+static netif_mqtt_client_t * client = NULL;
+static uint32_t now_ms = 0;
+static bool link_up = true;
+static bool connected = false;
+static uint32_t lose_next = 0;
+static bool at_busy = false;			// AT+MQTTPUB sent, OK not back yet
+static uint32_t at_done;
+static NETIFSIM_ack_t acks[NETIFSIM_ACK_QUEUE];
+static uint8_t ack_head = 0;
+static uint8_t ack_count = 0;
+static uint8_t eeprom[EEPROM_SIZE];
+static bool verbose = false;
+static const char * log_prefix = NULL;
+
+static void NETIFSIM_notify(uint8_t event, const char * topic, const char * payload);
+
+void NETIFSIM_init(NETIFSIM_link_t * config){
+	link = *config;
+	memset(&stats, 0, sizeof(stats));
+	memset(eeprom, 0xFF, sizeof(eeprom));
+	now_ms = 0;
+	link_up = true;
+	connected = false;
+	lose_next = 0;
+	at_busy = false;
+	ack_head = 0;
+	ack_count = 0;
+}
+
+// One superloop pass
+void NETIFSIM_tick(){
+	now_ms++;
+	NETIFSIM_dwt.CYCCNT += SystemCoreClock / 1000;
+}
+
+uint32_t NETIFSIM_now(){
+	return now_ms;
+}
+
+// A link down drops the connection and every on_publish still to come
+void NETIFSIM_set_link_up(bool up){
+	link_up = up;
+	if(up || !connected){
+		return;
+	}
+	connected = false;
+	at_busy = false;
+	stats.lost += ack_count;
+	ack_count = 0;
+	client->on_disconnect(0);
+}
+
+// The next count publishes are lost, on top of lose_every
+void NETIFSIM_lose_next(uint32_t count){
+	lose_next = count;
+}
+
+void NETIFSIM_set_observer(NETIFSIM_observer_t callback){
+	observer = callback;
+}
+
+NETIFSIM_stats_t * NETIFSIM_get_stats(){
+	return &stats;
+}
+
+void NETIFSIM_set_verbose(bool enable){
+	verbose = enable;
+}
+
+void NETIFSIM_show_log(const char * prefix){
+	log_prefix = prefix;
+}
+
+void NETIFSIM_log(const char * fmt, ...){
+	va_list args;
+	if(!verbose && (log_prefix == NULL || strncmp(fmt, log_prefix, strlen(log_prefix)) != 0)){
+		return;
+	}
+	va_start(args, fmt);
+	vprintf(fmt, args);
+	va_end(args);
+}
+
+uint32_t HAL_GetTick(void){
+	return now_ms;
+}
+
+// Device/eeprom.h, no write cycle: the outbox cost is not what is measured here
+bool EEPROM_read(uint16_t address , uint8_t * data, size_t data_len){
+	if(address + data_len > EEPROM_SIZE){
+		return false;
+	}
+	memcpy(data, &eeprom[address], data_len);
+	return true;
+}
+
+bool EEPROM_write(uint16_t address , uint8_t * data, size_t data_len){
+	if(address + data_len > EEPROM_SIZE){
+		return false;
+	}
+	memcpy(&eeprom[address], data, data_len);
+	return true;
+}
+
+// Lib/netif on the model
+uint32_t NETIF_GET_TIME_MS(){
+	return now_ms;
+}
+
+void netif_init(){
+}
+
+// Completions come back in publish order, once their round trip is over
+void netif_run(){
+	NETIFSIM_ack_t * ack;
+	while(ack_count > 0 && acks[ack_head].at <= now_ms){
+		ack = &acks[ack_head];
+		ack_head = (ack_head + 1) % NETIFSIM_ACK_QUEUE;
+		ack_count--;
+		if(ack->status == NETIF_OK){
+			stats.acked++;
+			NETIFSIM_notify(NETIFSIM_EVENT_ACK, ack->topic, ack->payload);
+		}else{
+			stats.failed++;
+		}
+		client->on_publish(ack->status);
+	}
+}
+
+netif_status_t netif_manager_is_connect_to_internet(bool * is_connected){
+	*is_connected = link_up;
+	return NETIF_OK;
+}
+
+netif_status_t netif_manager_reset(){
+	return NETIF_OK;
+}
+
+netif_status_t netif_mqtt_config(netif_mqtt_client_t * mqtt_client){
+	client = mqtt_client;
+	return NETIF_OK;
+}
+
+netif_status_t netif_mqtt_connect(netif_mqtt_client_t * mqtt_client){
+	if(!link_up){
+		return NETIF_FAIL;
+	}
+	connected = true;
+	mqtt_client->on_connect(0);
+	return NETIF_OK;
+}
+
+netif_status_t netif_mqtt_subcribe(netif_mqtt_client_t * mqtt_client, char * topic, uint8_t qos){
+	return link_up ? NETIF_OK : NETIF_FAIL;
+}
+
+/**
+ * The AT command takes at_ms, then the broker answers after ack_ms.
+ * A lost one never answers, mqtt.c has to give it up.
+ */
+netif_status_t netif_mqtt_publish(netif_mqtt_client_t * mqtt_client, char * topic, char * payload, uint8_t qos, uint8_t retain){
+	NETIFSIM_ack_t * ack;
+	if(!connected){
+		return NETIF_FAIL;
+	}
+	if(!at_busy){
+		at_busy = true;
+		at_done = now_ms + link.at_ms;
+		return NETIF_IN_PROCESS;
+	}
+	if(now_ms < at_done){
+		return NETIF_IN_PROCESS;
+	}
+	at_busy = false;
+	if(ack_count >= NETIFSIM_ACK_QUEUE){
+		return NETIF_FAIL;
+	}
+	stats.publishes++;
+	stats.bytes += strlen(topic) + strlen(payload);
+	NETIFSIM_notify(NETIFSIM_EVENT_PUBLISH, topic, payload);
+	if(lose_next > 0){
+		lose_next--;
+		stats.lost++;
+		return NETIF_OK;
+	}
+	if(link.lose_every != 0 && stats.publishes % link.lose_every == 0){
+		stats.lost++;
+		return NETIF_OK;
+	}
+	ack = &acks[(ack_head + ack_count) % NETIFSIM_ACK_QUEUE];
+	ack->at = now_ms + link.ack_ms;
+	ack->status = (link.fail_every != 0 && stats.publishes % link.fail_every == 0) ? NETIF_FAIL : NETIF_OK;
+	snprintf(ack->topic, sizeof(ack->topic), "%s", topic);
+	snprintf(ack->payload, sizeof(ack->payload), "%s", payload);
+	ack_count++;
+	return NETIF_OK;
+}
+
+static void NETIFSIM_notify(uint8_t event, const char * topic, const char * payload){
+	if(observer != NULL){
+		observer(event, topic, payload);
+	}
+}
@@ -0,0 +1,56 @@
+/*
+ * netifsim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xuanthodo
+ *
+ * Host model of the ESP32 AT link and the broker behind the netif API,
+ * and of the 24C32 as a plain array behind Device/eeprom.h, so that
+ * mqtt.c, outbox.c and statusreporter.c run unchanged on top of it.
+ * Time only moves with NETIFSIM_tick(), one superloop pass.
+ */
+
+#ifndef NETIFSIM_H_
+#define NETIFSIM_H_
+
+#include "stdint.h"
+#include "stddef.h"
+#include "stdbool.h"
+
+#define NETIFSIM_AT_MS				20		// AT+MQTTPUB until the ESP32 answers OK
+#define NETIFSIM_ACK_MS				150		// Publish to on_publish, the PUBACK round trip
+#define NETIFSIM_ACK_QUEUE			8		// Publishes waiting for their on_publish
+
+enum {
+	NETIFSIM_EVENT_PUBLISH,		// Accepted by netif_mqtt_publish
+	NETIFSIM_EVENT_ACK			// on_publish with success
+};
+
+typedef void (*NETIFSIM_observer_t)(uint8_t event, const char * topic, const char * payload);
+
+typedef struct {
+	uint32_t at_ms;
+	uint32_t ack_ms;
+	uint32_t lose_every;		// Every nth publish never gets its on_publish, 0 for none
+	uint32_t fail_every;		// Every nth publish gets on_publish with an error, 0 for none
+}NETIFSIM_link_t;
+
+typedef struct {
+	uint32_t publishes;
+	uint32_t bytes;				// Topic and payload of the publishes
+	uint32_t acked;
+	uint32_t failed;
+	uint32_t lost;
+}NETIFSIM_stats_t;
+
+void NETIFSIM_init(NETIFSIM_link_t * link);
+void NETIFSIM_tick();
+uint32_t NETIFSIM_now();
+void NETIFSIM_set_link_up(bool up);
+void NETIFSIM_lose_next(uint32_t count);
+void NETIFSIM_set_observer(NETIFSIM_observer_t observer);
+NETIFSIM_stats_t * NETIFSIM_get_stats();
+void NETIFSIM_set_verbose(bool verbose);
+void NETIFSIM_show_log(const char * prefix);
+
+#endif /* NETIFSIM_H_ */